@@ -20,7 +20,20 @@
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "CharArena.hpp"
 #include "Set.hpp"
 #include "AvlNode.hpp"
 
@@ -32,6 +45,78 @@ public:
     // ElementType and returns no value.
     using VisitFunction = std::function<void(const ElementType &)>;
 
+private:
+    // add() and const_iterator record the paths they follow on fixed
+    // stacks of this many entries, which is more than the height of any
+    // balanced tree with 2^32 nodes.  Only an unbalanced tree can outgrow
+    // them, in which case the parts of a path that didn't fit are found
+    // again by searching from the root.
+    static constexpr int MAX_PATH = 64;
+
+public:
+    // A const_iterator visits the elements in ascending order (or, going
+    // backward, descending).  It remembers the path from the root to its
+    // element, so moving to the next or previous element takes amortized
+    // constant time.  Decrementing an iterator at the first element gives
+    // end(), and decrementing end() gives the last element.  Adding to
+    // the set invalidates every iterator.
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ElementType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ElementType *;
+        using reference = const ElementType &;
+
+        const_iterator() noexcept;
+
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        const_iterator &operator--();
+        const_iterator operator--(int);
+
+        bool operator==(const const_iterator &other) const noexcept;
+        bool operator!=(const const_iterator &other) const noexcept;
+
+    private:
+        friend class AVLSet;
+
+        explicit const_iterator(const AVLSet *set) noexcept;
+
+        // Makes the given node (a child of the current one, or the root
+        // when there is none) the current one.
+        void push(const AvlNode<ElementType> *n) noexcept;
+
+        // Moves up the path for as long as the current node is the given
+        // child of its parent, then once more, ending at end() if it runs
+        // out of path.
+        void climb(AvlNode<ElementType> *AvlNode<ElementType>::*child) noexcept;
+
+        const AVLSet *set;
+        const AvlNode<ElementType> *node;
+
+        // path[0] is the root and path[depth - 1] is node, for as many of
+        // those as fit.
+        int depth;
+        const AvlNode<ElementType> *path[MAX_PATH];
+    };
+
+    using iterator = const_iterator;
+
+    // A Range is a pair of iterators that a range-based for loop can walk.
+    struct Range
+    {
+        const_iterator first;
+        const_iterator last;
+
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+    };
+
 public:
     // Initializes an AVLSet to be empty, with or without balancing.
     explicit AVLSet(bool shouldBalance = true);
@@ -39,7 +124,14 @@ public:
     // Cleans up the AVLSet so that it leaks no memory.
     ~AVLSet() noexcept override;
 
-    // Initializes a new AVLSet to be a copy of an existing one.
+    // Initializes a new AVLSet to be a copy of an existing one.  Copying
+    // takes constant time: the two sets share every node (each node counts
+    // the parents and sets that refer to it), and whichever set is added
+    // to afterward copies just the shared nodes it would have changed,
+    // which are the O(log n) on the path to the new element.  Neither set
+    // ever changes a node the other can reach, so one thread can keep
+    // searching a copy, without locking, while another adds to the
+    // original.
     AVLSet(const AVLSet &s);
 
     // Initializes a new AVLSet whose contents are moved from an
@@ -58,14 +150,25 @@ public:
 
     // add() adds an element to the set.  If the element is already in the set,
     // this function has no effect.  This function always runs in O(log n) time
-    // when there are n elements in the AVL tree.
+    // when there are n elements in the AVL tree.  Once concurrent reads are
+    // allowed, it waits for any other add() that is underway to finish first.
     void add(const ElementType &element) override;
 
+    using Set<ElementType>::contains;
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function always runs in O(log n) time when
-    // there are n elements in the AVL tree.
+    // there are n elements in the AVL tree.  Once concurrent reads are
+    // allowed, it returns true if the element was in the set at some point
+    // during the call, and runs in O(log n) time per attempt, starting over
+    // only when a rotation moved a node it was relying on.
     bool contains(const ElementType &element) const override;
 
+    // contains() can also be asked about a std::string_view, in which case
+    // each node's element is compared against the view directly, without
+    // building a string to search for.
+    bool contains(std::string_view element) const override;
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -88,6 +191,72 @@ public:
     // tree.
     void postorder(VisitFunction visit) const;
 
+    // addSorted() adds every element in the range [begin, end), which is
+    // expected to be in ascending order (duplicates are allowed), by
+    // merging them with the elements already in the set and rebuilding
+    // the whole tree as a perfectly balanced one.  This runs in O(n + m)
+    // time, where n is the size of the set and m is the length of the
+    // range, with no rotations.  If the range turns out not to be sorted,
+    // a sorted copy of it is merged instead.
+    template <typename Iterator>
+    void addSorted(Iterator begin, Iterator end);
+
+    // freeze() copies the elements into an array in "Eytzinger" order: the
+    // order in which a breadth-first traversal would visit them if they
+    // were in a perfectly balanced tree, so that the children of the
+    // element at index k are at indexes 2k and 2k + 1 and the top levels
+    // of the tree share a handful of cache lines.  (For std::string
+    // elements, the characters are laid out in the same order, and the
+    // array holds their offsets and lengths, along with their first eight
+    // characters, which settle most comparisons without following the
+    // offset.)  Until the next element is added, contains() searches the
+    // array rather than the tree, choosing a child arithmetically rather
+    // than with a branch and prefetching the elements four levels
+    // further down.
+    void freeze();
+
+    // isFrozen() returns true if contains() is searching the array built
+    // by freeze().
+    bool isFrozen() const noexcept;
+
+    // allowConcurrentReads() lets any number of threads call contains()
+    // while other threads call add().  Writers take a lock, and every
+    // rotation bumps the version of the node it moves down before and
+    // after relinking it; readers take no lock, and, on their way down,
+    // read each child's version and then check that neither its parent's
+    // version nor its parent's link to it has changed since, starting
+    // over from the root if either has.  Because nodes are never removed,
+    // an element that a reader finds is always in the set.  From then on,
+    // freeze() does nothing and addSorted() adds its elements one at a
+    // time, since both would replace nodes readers might be using.  Only
+    // add() and contains() may be called concurrently; copying, moving,
+    // assigning, iterating, and everything else must not overlap an add().
+    // This should be called before any other thread uses the set.
+    void allowConcurrentReads();
+
+    // allowsConcurrentReads() returns true once allowConcurrentReads() has
+    // been called.
+    bool allowsConcurrentReads() const noexcept;
+
+    // begin() and end() return iterators at the smallest element and just
+    // past the largest one.
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    // lower_bound() returns an iterator at the smallest element that isn't
+    // less than the given one, and upper_bound() at the smallest element
+    // that's greater than it (or end(), if there is none).  Each descends
+    // the tree once.  A set of strings can also be asked about a
+    // std::string_view.
+    const_iterator lower_bound(const ElementType &element) const;
+    const_iterator lower_bound(std::string_view element) const;
+    const_iterator upper_bound(const ElementType &element) const;
+
+    // prefixRange() returns the range of elements that begin with the given
+    // prefix, in ascending order, found by descending the tree once to
+    // each end of it; walking it visits only those elements.
+    Range prefixRange(std::string_view prefix) const;
+
 private:
     // You'll no doubt want to add member variables and "helper" member
     // functions here.
@@ -95,6 +264,10 @@ private:
     AvlNode<ElementType> *root;
     int levelAVL;
 
+    // Set by allowConcurrentReads(); add() holds writerMutex while it runs.
+    bool concurrent = false;
+    std::mutex writerMutex;
+
     void balanceRight(AvlNode<ElementType> *&_node1);
     void balanceLeft(AvlNode<ElementType> *&_node2);
     void doubleBalanceRight(AvlNode<ElementType> *&_node3);
@@ -102,13 +275,109 @@ private:
     void preOrderAssist(const AvlNode<ElementType> *&root, VisitFunction visit) const;
     void inOrderAssist(const AvlNode<ElementType> *&root, VisitFunction visit) const;
     void postOrderAssist(const AvlNode<ElementType> *&root, VisitFunction visit) const;
-    void clearAVL(AvlNode<ElementType> *&t) const;
-    AvlNode<ElementType> *cloneNode(AvlNode<ElementType> *t) const;
-    void add(const ElementType &element, AvlNode<ElementType> *&root);
-    void addCount(const ElementType &element);
-    void addCount(ElementType element, AvlNode<ElementType> *&root);
+    // release() drops one reference to the given node, destroying it
+    // (and dropping its references to its children) if it was the last.
+    static void release(AvlNode<ElementType> *t) noexcept;
+
+    // unshare() makes sure the node the given link points to is referred
+    // to by nothing else, copying it into the link if necessary, and
+    // returns it.  unshareTree() does the same for every node in the tree.
+    static AvlNode<ElementType> *unshare(AvlNode<ElementType> *&link);
+    void unshareTree();
+
+    // Returns a negative value, zero, or a positive value when the given
+    // element (an ElementType or a std::string_view), whose prefix is
+    // given, is less than, equal to, or greater than the given node's.
+    // Strings are compared by their prefixes first, and then, only if
+    // those are equal, once with compare().
+    template <typename Key>
+    static int compareWith(const Key &element, std::uint64_t elementPrefix, const AvlNode<ElementType> *n);
+
+    template <typename Key>
+    bool findInTree(const Key &element) const;
+
+    // findInTree() for when writers may be changing the tree underneath.
+    template <typename Key>
+    bool findValidated(const Key &element) const;
+
+    // Links are read by readers that hold no lock, so changes to them are
+    // release stores and concurrent reads of them are acquire loads.
+    static AvlNode<ElementType> *loadLink(AvlNode<ElementType> *const &link) noexcept;
+    static void storeLink(AvlNode<ElementType> *&link, AvlNode<ElementType> *n) noexcept;
+
+    // Returns the given node's version once it's even, i.e., once no
+    // rotation is moving it.
+    static unsigned int stableVersion(const AvlNode<ElementType> *n) noexcept;
+
+    // beginChange() makes the given node's version odd before a rotation
+    // moves it down; endChange() makes it even again afterward.
+    static void beginChange(AvlNode<ElementType> *n) noexcept;
+    static void endChange(AvlNode<ElementType> *n) noexcept;
+
+    // When add()'s path doesn't fit on its stack, deepenPath() updates the
+    // heights along it instead.
+    void deepenPath(const AvlNode<ElementType> *added, int depth);
+
+    template <typename Iterator>
+    void mergeSorted(Iterator begin, Iterator end);
+    void collectInorder(std::vector<AvlNode<ElementType> *> &nodes) const;
+    AvlNode<ElementType> *buildBalanced(AvlNode<ElementType> *const *nodes, std::size_t count);
     int max(int a1, int a2) const;
     int getLevel(AvlNode<ElementType> *root);
+
+    // A std::string element's first eight characters are kept alongside
+    // its offset and length, packed as in AvlNode; only when two packed
+    // prefixes are equal do the characters themselves need to be read.
+    struct FrozenString
+    {
+        std::uint64_t prefix;
+        unsigned int offset;
+        unsigned int length;
+    };
+
+    static constexpr bool FREEZES_CHARS = std::is_same_v<ElementType, std::string>;
+
+    using FrozenElement = std::conditional_t<FREEZES_CHARS, FrozenString, ElementType>;
+
+    // The array is allocated on a cache-line boundary, so the descendants
+    // of index k that are FROZEN_PREFETCH_LEVELS levels further down, at
+    // indexes k * 2^FROZEN_PREFETCH_LEVELS onward, start a line of their
+    // own; contains() prefetches the lines they fill (four for a
+    // FrozenString, one for an int, and never more than four) before
+    // comparing at k.
+    static constexpr std::size_t FROZEN_ALIGNMENT = 64;
+    static constexpr std::size_t FROZEN_PREFETCH_LEVELS = 4;
+    static constexpr std::size_t FROZEN_PREFETCH_LINES = std::min<std::size_t>(
+        4, ((sizeof(FrozenElement) << FROZEN_PREFETCH_LEVELS) + FROZEN_ALIGNMENT - 1) / FROZEN_ALIGNMENT);
+
+    // The array built by freeze(), numbered from 1 (element 0 is unused),
+    // or nullptr when the set isn't frozen.  It holds frozenCount + 1
+    // elements.
+    FrozenElement *frozen = nullptr;
+    std::size_t frozenCount = 0;
+    CharArena frozenChars;
+
+    void layOutFrozen(
+        const std::vector<AvlNode<ElementType> *> &sorted, std::vector<AvlNode<ElementType> *> &order,
+        std::size_t &next, std::size_t k);
+    void thaw() noexcept;
+
+    void prefetchFrozenDescendants(std::size_t k) const noexcept;
+
+    template <typename Key>
+    bool frozenContains(const Key &element) const;
+
+    // Returns an iterator at the first element for which the given
+    // predicate returns true, given that it returns false for every
+    // element before that one and true for every element after it.
+    template <typename Predicate>
+    const_iterator seekFirst(Predicate isAtOrAfter) const;
+
+    // Returns an iterator at the last element for which the given
+    // predicate returns true, given that it returns true for every element
+    // before that one and false for every element after it.
+    template <typename Predicate>
+    const_iterator seekLast(Predicate isBefore) const;
 };
 
 template <typename ElementType>
@@ -122,7 +391,8 @@ AVLSet<ElementType>::AVLSet(bool shouldBalance)
 template <typename ElementType>
 AVLSet<ElementType>::~AVLSet() noexcept
 {
-    clearAVL(this->root);
+    thaw();
+    release(this->root);
     levelAVL = 0;
 }
 
@@ -132,6 +402,10 @@ AVLSet<ElementType>::AVLSet(const AVLSet &s)
     this->bBalance = s.bBalance;
     this->levelAVL = s.levelAVL;
     this->root = s.root;
+    this->concurrent = s.concurrent;
+
+    if (this->root != NULL)
+        this->root->refs.fetch_add(1, std::memory_order_relaxed);
 }
 
 template <typename ElementType>
@@ -139,7 +413,13 @@ AVLSet<ElementType>::AVLSet(AVLSet &&s) noexcept
 {
     this->bBalance = std::move(s.bBalance);
     this->levelAVL = std::move(s.levelAVL);
-    this->root = std::move(s.root);
+    this->root = s.root;
+    this->concurrent = s.concurrent;
+    s.root = NULL;
+    s.levelAVL = 0;
+    std::swap(this->frozen, s.frozen);
+    std::swap(this->frozenCount, s.frozenCount);
+    this->frozenChars.swap(s.frozenChars);
 }
 
 template <typename ElementType>
@@ -147,8 +427,8 @@ AVLSet<ElementType> &AVLSet<ElementType>::operator=(const AVLSet &s)
 {
     if (this != &s)
     {
-        clearAVL(root);
-        root = cloneNode(s.root);
+        AVLSet copy{s};
+        *this = std::move(copy);
     }
     return *this;
 }
@@ -156,11 +436,13 @@ AVLSet<ElementType> &AVLSet<ElementType>::operator=(const AVLSet &s)
 template <typename ElementType>
 AVLSet<ElementType> &AVLSet<ElementType>::operator=(AVLSet &&s) noexcept
 {
-    if (this != &s)
-    {
-        clearAVL(root);
-        root = cloneNode(s.root);
-    }
+    std::swap(bBalance, s.bBalance);
+    std::swap(root, s.root);
+    std::swap(levelAVL, s.levelAVL);
+    std::swap(concurrent, s.concurrent);
+    std::swap(frozen, s.frozen);
+    std::swap(frozenCount, s.frozenCount);
+    frozenChars.swap(s.frozenChars);
     return *this;
 }
 
@@ -173,35 +455,239 @@ bool AVLSet<ElementType>::isImplemented() const noexcept
 template <typename ElementType>
 void AVLSet<ElementType>::add(const ElementType &element)
 {
-    if (contains(element))
+    std::unique_lock<std::mutex> lock{writerMutex, std::defer_lock};
+
+    if (concurrent)
+        lock.lock();
+
+    AvlNode<ElementType> **path[MAX_PATH];
+    AvlNode<ElementType> **link = &this->root;
+    int depth = 0;
+
+    std::uint64_t elementPrefix = AvlNode<ElementType>::prefixOf(element);
+
+    while (*link != NULL)
+    {
+        AvlNode<ElementType> *n = unshare(*link);
+        int comparison = compareWith(element, elementPrefix, n);
+
+        if (comparison == 0)
+        {
+            n->count += 1;
+            return;
+        }
+
+        if (depth < MAX_PATH)
+            path[depth] = link;
+        depth++;
+        link = comparison < 0 ? &n->pLeft : &n->pRight;
+    }
+
+    thaw();
+    storeLink(*link, new AvlNode<ElementType>(element, NULL, NULL, 0, 1));
+    levelAVL++;
+
+    if (depth > MAX_PATH)
     {
-        addCount(element);
+        deepenPath(*link, depth);
+        return;
     }
-    else
+
+    for (int i = depth - 1; i >= 0; i--)
     {
-        add(element, this->root);
-        levelAVL++;
+        AvlNode<ElementType> *&n = *path[i];
+        int oldDeep = n->deep;
+        n->deep = max(getLevel(n->pLeft), getLevel(n->pRight)) + 1;
+
+        if (bBalance == true)
+        {
+            if (getLevel(n->pLeft) - getLevel(n->pRight) == 2)
+            {
+                if (element < n->pLeft->element)
+                    balanceLeft(n);
+                else
+                    doubleBalanceRight(n);
+                return;
+            }
+            else if (getLevel(n->pRight) - getLevel(n->pLeft) == 2)
+            {
+                if (n->pRight->element < element)
+                    balanceRight(n);
+                else
+                    doubleBalanceLeft(n);
+                return;
+            }
+        }
+
+        if (n->deep == oldDeep)
+            return;
     }
 }
 
 template <typename ElementType>
 bool AVLSet<ElementType>::contains(const ElementType &element) const
 {
-    AvlNode<ElementType> *n = this->root;
+    if (concurrent)
+        return findValidated(element);
+
+    if (frozen != nullptr)
+        return frozenContains(element);
+
+    return findInTree(element);
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::contains(std::string_view element) const
+{
+    if constexpr (std::is_convertible_v<const ElementType &, std::string_view>)
+    {
+        if (concurrent)
+            return findValidated(element);
+
+        if (frozen != nullptr)
+            return frozenContains(element);
+
+        return findInTree(element);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+template <typename ElementType>
+template <typename Key>
+int AVLSet<ElementType>::compareWith(const Key &element, std::uint64_t elementPrefix, const AvlNode<ElementType> *n)
+{
+    if constexpr (std::is_convertible_v<const ElementType &, std::string_view>)
+    {
+        if (elementPrefix != n->prefix)
+            return elementPrefix < n->prefix ? -1 : 1;
+
+        return std::string_view{element}.compare(n->element);
+    }
+    else
+    {
+        if (element < n->element)
+            return -1;
+        else if (n->element < element)
+            return 1;
+        else
+            return 0;
+    }
+}
+
+template <typename ElementType>
+template <typename Key>
+bool AVLSet<ElementType>::findInTree(const Key &element) const
+{
+    std::uint64_t elementPrefix = 0;
+
+    if constexpr (std::is_convertible_v<const ElementType &, std::string_view>)
+        elementPrefix = impl_::AvlNode__prefixOf(element);
+
+    const AvlNode<ElementType> *n = this->root;
 
     while (n != NULL)
     {
-        if (element == n->element)
+        int comparison = compareWith(element, elementPrefix, n);
+
+        if (comparison == 0)
             return true;
-        else if (element < n->element)
-            n = n->pLeft;
-        else if (element > n->element)
-            n = n->pRight;
+
+        n = comparison < 0 ? n->pLeft : n->pRight;
     }
 
     return false;
 }
 
+template <typename ElementType>
+template <typename Key>
+bool AVLSet<ElementType>::findValidated(const Key &element) const
+{
+    std::uint64_t elementPrefix = 0;
+
+    if constexpr (std::is_convertible_v<const ElementType &, std::string_view>)
+        elementPrefix = impl_::AvlNode__prefixOf(element);
+
+    for (;;)
+    {
+        const AvlNode<ElementType> *n = loadLink(this->root);
+
+        if (n == NULL)
+            return false;
+
+        unsigned int version = stableVersion(n);
+
+        if (loadLink(this->root) != n)
+            continue;
+
+        for (;;)
+        {
+            int comparison = compareWith(element, elementPrefix, n);
+
+            if (comparison == 0)
+                return true;
+
+            AvlNode<ElementType> *const &link = comparison < 0 ? n->pLeft : n->pRight;
+            const AvlNode<ElementType> *child = loadLink(link);
+            unsigned int childVersion = child == NULL ? 0 : stableVersion(child);
+
+            // If n was moved down, or the link no longer leads to child,
+            // then child's subtree may not be where the element would be.
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (n->version.load(std::memory_order_relaxed) != version || loadLink(link) != child)
+                break;
+
+            if (child == NULL)
+                return false;
+
+            n = child;
+            version = childVersion;
+        }
+    }
+}
+
+template <typename ElementType>
+AvlNode<ElementType> *AVLSet<ElementType>::loadLink(AvlNode<ElementType> *const &link) noexcept
+{
+    return __atomic_load_n(&link, __ATOMIC_ACQUIRE);
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::storeLink(AvlNode<ElementType> *&link, AvlNode<ElementType> *n) noexcept
+{
+    __atomic_store_n(&link, n, __ATOMIC_RELEASE);
+}
+
+template <typename ElementType>
+unsigned int AVLSet<ElementType>::stableVersion(const AvlNode<ElementType> *n) noexcept
+{
+    unsigned int version = n->version.load(std::memory_order_acquire);
+
+    while ((version & 1) != 0)
+        version = n->version.load(std::memory_order_acquire);
+
+    return version;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::beginChange(AvlNode<ElementType> *n) noexcept
+{
+    // Only a writer holding the lock changes versions, so this needn't be
+    // a read-modify-write; the fence keeps the relinking that follows from
+    // becoming visible before the odd version does.
+    n->version.store(n->version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::endChange(AvlNode<ElementType> *n) noexcept
+{
+    n->version.store(n->version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
 template <typename ElementType>
 unsigned int AVLSet<ElementType>::size() const noexcept
 {
@@ -235,6 +721,473 @@ void AVLSet<ElementType>::postorder(VisitFunction visit) const
     postOrderAssist(n, visit);
 }
 
+template <typename ElementType>
+template <typename Iterator>
+void AVLSet<ElementType>::addSorted(Iterator begin, Iterator end)
+{
+    if (concurrent)
+    {
+        for (; begin != end; ++begin)
+            add(*begin);
+    }
+    else if (std::is_sorted(begin, end))
+    {
+        mergeSorted(begin, end);
+    }
+    else
+    {
+        std::vector<ElementType> sorted{begin, end};
+        std::sort(sorted.begin(), sorted.end());
+        mergeSorted(sorted.begin(), sorted.end());
+    }
+}
+
+template <typename ElementType>
+template <typename Iterator>
+void AVLSet<ElementType>::mergeSorted(Iterator begin, Iterator end)
+{
+    thaw();
+    unshareTree();
+
+    std::vector<AvlNode<ElementType> *> existing;
+    collectInorder(existing);
+
+    std::vector<AvlNode<ElementType> *> merged;
+    merged.reserve(existing.size() + static_cast<std::size_t>(std::distance(begin, end)));
+
+    std::size_t i = 0;
+
+    while (begin != end || i < existing.size())
+    {
+        if (begin == end)
+        {
+            merged.push_back(existing[i++]);
+        }
+        else if (!merged.empty() && !(merged.back()->element < *begin))
+        {
+            merged.back()->count += 1;
+            ++begin;
+        }
+        else if (i < existing.size() && !(*begin < existing[i]->element))
+        {
+            merged.push_back(existing[i++]);
+        }
+        else
+        {
+            merged.push_back(new AvlNode<ElementType>(*begin, NULL, NULL, 0, 1));
+            levelAVL++;
+            ++begin;
+        }
+    }
+
+    this->root = buildBalanced(merged.data(), merged.size());
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::collectInorder(std::vector<AvlNode<ElementType> *> &nodes) const
+{
+    nodes.reserve(levelAVL);
+
+    std::vector<AvlNode<ElementType> *> pending;
+    AvlNode<ElementType> *n = this->root;
+
+    while (n != NULL || !pending.empty())
+    {
+        while (n != NULL)
+        {
+            pending.push_back(n);
+            n = n->pLeft;
+        }
+
+        n = pending.back();
+        pending.pop_back();
+        nodes.push_back(n);
+        n = n->pRight;
+    }
+}
+
+template <typename ElementType>
+AvlNode<ElementType> *AVLSet<ElementType>::buildBalanced(AvlNode<ElementType> *const *nodes, std::size_t count)
+{
+    if (count == 0)
+        return NULL;
+
+    std::size_t middle = count / 2;
+    AvlNode<ElementType> *n = nodes[middle];
+    n->pLeft = buildBalanced(nodes, middle);
+    n->pRight = buildBalanced(nodes + middle + 1, count - middle - 1);
+    n->deep = max(getLevel(n->pLeft), getLevel(n->pRight)) + 1;
+    return n;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::freeze()
+{
+    if (concurrent)
+        return;
+
+    thaw();
+
+    std::vector<AvlNode<ElementType> *> sorted;
+    collectInorder(sorted);
+
+    std::vector<AvlNode<ElementType> *> order(sorted.size() + 1);
+    std::size_t next = 0;
+    layOutFrozen(sorted, order, next, 1);
+
+    void *storage = ::operator new[](order.size() * sizeof(FrozenElement), std::align_val_t{FROZEN_ALIGNMENT});
+
+    try
+    {
+        std::uninitialized_default_construct_n(static_cast<FrozenElement *>(storage), order.size());
+    }
+    catch (...)
+    {
+        ::operator delete[](storage, std::align_val_t{FROZEN_ALIGNMENT});
+        throw;
+    }
+
+    frozen = static_cast<FrozenElement *>(storage);
+    frozenCount = sorted.size();
+
+    for (std::size_t k = 1; k <= frozenCount; k++)
+    {
+        if constexpr (FREEZES_CHARS)
+        {
+            const std::string &element = order[k]->element;
+            frozen[k] = FrozenString{
+                impl_::AvlNode__prefixOf(element), frozenChars.append(element), static_cast<unsigned int>(element.length())};
+        }
+        else
+        {
+            frozen[k] = order[k]->element;
+        }
+    }
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::isFrozen() const noexcept
+{
+    return frozen != nullptr;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::allowConcurrentReads()
+{
+    thaw();
+    concurrent = true;
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::allowsConcurrentReads() const noexcept
+{
+    return concurrent;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::layOutFrozen(
+    const std::vector<AvlNode<ElementType> *> &sorted, std::vector<AvlNode<ElementType> *> &order,
+    std::size_t &next, std::size_t k)
+{
+    // An inorder walk of the implicit tree visits its indexes in the order
+    // of the elements they should hold.
+    if (k >= order.size())
+        return;
+
+    layOutFrozen(sorted, order, next, 2 * k);
+    order[k] = sorted[next++];
+    layOutFrozen(sorted, order, next, 2 * k + 1);
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::thaw() noexcept
+{
+    if (frozen != nullptr)
+    {
+        std::destroy_n(frozen, frozenCount + 1);
+        ::operator delete[](frozen, std::align_val_t{FROZEN_ALIGNMENT});
+    }
+
+    frozen = nullptr;
+    frozenCount = 0;
+    frozenChars = CharArena{};
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::prefetchFrozenDescendants(std::size_t k) const noexcept
+{
+    // Prefetches don't fault, so it doesn't matter when these lines are
+    // past the end of the array.
+    const char *first = reinterpret_cast<const char *>(frozen + (k << FROZEN_PREFETCH_LEVELS));
+
+    for (std::size_t line = 0; line < FROZEN_PREFETCH_LINES; line++)
+        __builtin_prefetch(first + line * FROZEN_ALIGNMENT);
+}
+
+template <typename ElementType>
+template <typename Key>
+bool AVLSet<ElementType>::frozenContains(const Key &element) const
+{
+    std::size_t k = 1;
+
+    if constexpr (FREEZES_CHARS)
+    {
+        std::string_view key{element};
+        std::uint64_t keyPrefix = impl_::AvlNode__prefixOf(key);
+
+        while (k <= frozenCount)
+        {
+            prefetchFrozenDescendants(k);
+
+            const FrozenString &candidate = frozen[k];
+            bool less = candidate.prefix != keyPrefix
+                ? candidate.prefix < keyPrefix
+                : frozenChars.view(candidate.offset, candidate.length) < key;
+
+            k = 2 * k + less;
+        }
+    }
+    else
+    {
+        while (k <= frozenCount)
+        {
+            prefetchFrozenDescendants(k);
+            k = 2 * k + (frozen[k] < element);
+        }
+    }
+
+    // k went right after each of the elements less than the one we're
+    // looking for and left at the smallest that isn't; dropping the
+    // trailing right turns (and the left turn before them) leaves the
+    // index of that smallest one, or 0 if every element is less.
+    k >>= __builtin_ffsll(static_cast<long long>(~k));
+
+    if (k == 0)
+        return false;
+
+    if constexpr (FREEZES_CHARS)
+        return frozenChars.view(frozen[k].offset, frozen[k].length) == std::string_view{element};
+    else
+        return !(element < frozen[k]) && !(frozen[k] < element);
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::begin() const
+{
+    return seekFirst([](const ElementType &) { return true; });
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::end() const
+{
+    return const_iterator{this};
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::lower_bound(const ElementType &element) const
+{
+    return seekFirst([&](const ElementType &e) { return !(e < element); });
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::lower_bound(std::string_view element) const
+{
+    return seekFirst([&](const ElementType &e) { return !(std::string_view{e} < element); });
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::upper_bound(const ElementType &element) const
+{
+    return seekFirst([&](const ElementType &e) { return element < e; });
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::Range AVLSet<ElementType>::prefixRange(std::string_view prefix) const
+{
+    // The elements that begin with the prefix are the ones whose first
+    // prefix.length() characters are equal to it, so they sit together
+    // between the ones whose first characters compare less and greater.
+    auto first = seekFirst(
+        [&](const ElementType &e) { return std::string_view{e}.compare(0, prefix.length(), prefix) >= 0; });
+
+    auto last = seekFirst(
+        [&](const ElementType &e) { return std::string_view{e}.compare(0, prefix.length(), prefix) > 0; });
+
+    return Range{first, last};
+}
+
+template <typename ElementType>
+template <typename Predicate>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::seekFirst(Predicate isAtOrAfter) const
+{
+    const_iterator i{this};
+    const AvlNode<ElementType> *found = NULL;
+    int foundDepth = 0;
+
+    for (const AvlNode<ElementType> *n = this->root; n != NULL;)
+    {
+        i.push(n);
+
+        if (isAtOrAfter(n->element))
+        {
+            found = n;
+            foundDepth = i.depth;
+            n = n->pLeft;
+        }
+        else
+            n = n->pRight;
+    }
+
+    i.node = found;
+    i.depth = foundDepth;
+    return i;
+}
+
+template <typename ElementType>
+template <typename Predicate>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::seekLast(Predicate isBefore) const
+{
+    const_iterator i{this};
+    const AvlNode<ElementType> *found = NULL;
+    int foundDepth = 0;
+
+    for (const AvlNode<ElementType> *n = this->root; n != NULL;)
+    {
+        i.push(n);
+
+        if (isBefore(n->element))
+        {
+            found = n;
+            foundDepth = i.depth;
+            n = n->pRight;
+        }
+        else
+            n = n->pLeft;
+    }
+
+    i.node = found;
+    i.depth = foundDepth;
+    return i;
+}
+
+template <typename ElementType>
+AVLSet<ElementType>::const_iterator::const_iterator() noexcept
+    : set{NULL}, node{NULL}, depth{0}
+{
+}
+
+template <typename ElementType>
+AVLSet<ElementType>::const_iterator::const_iterator(const AVLSet *set) noexcept
+    : set{set}, node{NULL}, depth{0}
+{
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator::reference AVLSet<ElementType>::const_iterator::operator*() const noexcept
+{
+    return node->element;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator::pointer AVLSet<ElementType>::const_iterator::operator->() const noexcept
+{
+    return &node->element;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator &AVLSet<ElementType>::const_iterator::operator++()
+{
+    if (depth > MAX_PATH)
+    {
+        const ElementType &element = node->element;
+        *this = set->seekFirst([&](const ElementType &e) { return element < e; });
+    }
+    else if (node->pRight != NULL)
+    {
+        push(node->pRight);
+
+        while (node->pLeft != NULL)
+            push(node->pLeft);
+    }
+    else
+        climb(&AvlNode<ElementType>::pRight);
+
+    return *this;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::const_iterator::operator++(int)
+{
+    const_iterator old = *this;
+    ++*this;
+    return old;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator &AVLSet<ElementType>::const_iterator::operator--()
+{
+    if (node == NULL)
+    {
+        *this = set->seekLast([](const ElementType &) { return true; });
+    }
+    else if (depth > MAX_PATH)
+    {
+        const ElementType &element = node->element;
+        *this = set->seekLast([&](const ElementType &e) { return e < element; });
+    }
+    else if (node->pLeft != NULL)
+    {
+        push(node->pLeft);
+
+        while (node->pRight != NULL)
+            push(node->pRight);
+    }
+    else
+        climb(&AvlNode<ElementType>::pLeft);
+
+    return *this;
+}
+
+template <typename ElementType>
+typename AVLSet<ElementType>::const_iterator AVLSet<ElementType>::const_iterator::operator--(int)
+{
+    const_iterator old = *this;
+    --*this;
+    return old;
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::const_iterator::operator==(const const_iterator &other) const noexcept
+{
+    return node == other.node;
+}
+
+template <typename ElementType>
+bool AVLSet<ElementType>::const_iterator::operator!=(const const_iterator &other) const noexcept
+{
+    return node != other.node;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::const_iterator::push(const AvlNode<ElementType> *n) noexcept
+{
+    if (depth < MAX_PATH)
+        path[depth] = n;
+
+    depth++;
+    node = n;
+}
+
+template <typename ElementType>
+void AVLSet<ElementType>::const_iterator::climb(AvlNode<ElementType> *AvlNode<ElementType>::*child) noexcept
+{
+    while (depth > 1 && path[depth - 2]->*child == path[depth - 1])
+        depth--;
+
+    depth--;
+    node = depth > 0 ? path[depth - 1] : NULL;
+}
+
 template <typename ElementType>
 void AVLSet<ElementType>::preOrderAssist(const AvlNode<ElementType> *&root, VisitFunction visit) const
 {
@@ -290,22 +1243,28 @@ template <typename ElementType>
 void AVLSet<ElementType>::balanceLeft(AvlNode<ElementType> *&_node2)
 {
     AvlNode<ElementType> *_node1 = _node2->pLeft;
-    _node2->pLeft = _node1->pRight;
-    _node1->pRight = _node2;
+    AvlNode<ElementType> *moved = _node2;
+    beginChange(moved);
+    storeLink(_node2->pLeft, _node1->pRight);
+    storeLink(_node1->pRight, _node2);
     _node2->deep = max(getLevel(_node2->pLeft), getLevel(_node2->pRight)) + 1;
     _node1->deep = max(getLevel(_node1->pLeft), _node2->deep) + 1;
-    _node2 = _node1;
+    storeLink(_node2, _node1);
+    endChange(moved);
 }
 
 template <typename ElementType>
 void AVLSet<ElementType>::balanceRight(AvlNode<ElementType> *&_node1)
 {
     AvlNode<ElementType> *_node2 = _node1->pRight;
-    _node1->pRight = _node2->pLeft;
-    _node2->pLeft = _node1;
+    AvlNode<ElementType> *moved = _node1;
+    beginChange(moved);
+    storeLink(_node1->pRight, _node2->pLeft);
+    storeLink(_node2->pLeft, _node1);
     _node1->deep = max(getLevel(_node1->pLeft), getLevel(_node1->pRight)) + 1;
     _node2->deep = max(getLevel(_node2->pRight), _node1->deep) + 1;
-    _node1 = _node2;
+    storeLink(_node1, _node2);
+    endChange(moved);
 }
 
 template <typename ElementType>
@@ -323,82 +1282,81 @@ void AVLSet<ElementType>::doubleBalanceLeft(AvlNode<ElementType> *&_node4)
 }
 
 template <typename ElementType>
-void AVLSet<ElementType>::addCount(const ElementType &element)
+void AVLSet<ElementType>::deepenPath(const AvlNode<ElementType> *added, int depth)
 {
-    addCount(element, this->root);
-}
+    // Without balancing, every node on the path to the new one at the
+    // given depth is at least as tall as the distance down to it.
+    AvlNode<ElementType> *n = this->root;
 
-template <typename ElementType>
-void AVLSet<ElementType>::addCount(ElementType element, AvlNode<ElementType> *&root)
-{
-    if (element < root->element)
-        addCount(element, root->pLeft);
-    if (element > root->element)
-        addCount(element, root->pRight);
-    else
-        root->count += 1;
+    for (int d = 0; n != added; d++)
+    {
+        n->deep = max(n->deep, depth - d);
+        n = added->element < n->element ? n->pLeft : n->pRight;
+    }
 }
 
 template <typename ElementType>
-void AVLSet<ElementType>::add(const ElementType &element, AvlNode<ElementType> *&root)
+void AVLSet<ElementType>::release(AvlNode<ElementType> *t) noexcept
 {
-    if (root == NULL)
-    {
-        root = new AvlNode<ElementType>(element, NULL, NULL, 0, 0);
-        root->count = 1;
-    }
-    else if (element < root->element)
-    {
-        add(element, root->pLeft);
-        if (bBalance == true)
-        {
-            if ((getLevel(root->pLeft) - getLevel(root->pRight)) == 2)
-            {
-                if (element < root->pLeft->element)
-                    balanceLeft(root);
-                else
-                    doubleBalanceRight(root);
-            }
-        }
-    }
-    else if (root->element < element)
+    std::vector<AvlNode<ElementType> *> pending;
+
+    while (t != NULL)
     {
-        add(element, root->pRight);
-        if (bBalance == true)
+        if (t->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
         {
-            if (getLevel(root->pRight) - getLevel(root->pLeft) == 2)
-            {
-                if (root->pRight->element < element)
-                    balanceRight(root);
-                else
-                    doubleBalanceLeft(root);
-            }
+            if (t->pLeft != NULL)
+                pending.push_back(t->pLeft);
+            if (t->pRight != NULL)
+                pending.push_back(t->pRight);
+            delete t;
         }
-    }
 
-    if (root != NULL)
-        root->deep = max(getLevel(root->pLeft), getLevel(root->pRight)) + 1;
+        if (pending.empty())
+            break;
+
+        t = pending.back();
+        pending.pop_back();
+    }
 }
 
 template <typename ElementType>
-void AVLSet<ElementType>::clearAVL(AvlNode<ElementType> *&t) const
+AvlNode<ElementType> *AVLSet<ElementType>::unshare(AvlNode<ElementType> *&link)
 {
-    if (t != NULL)
-    {
-        clearAVL(t->pLeft);
-        clearAVL(t->pRight);
-        delete t;
-    }
-    t = NULL;
+    AvlNode<ElementType> *n = link;
+
+    if (n->refs.load(std::memory_order_acquire) == 1)
+        return n;
+
+    AvlNode<ElementType> *copy = new AvlNode<ElementType>(n->element, n->pLeft, n->pRight, n->deep, n->count);
+
+    if (copy->pLeft != NULL)
+        copy->pLeft->refs.fetch_add(1, std::memory_order_relaxed);
+    if (copy->pRight != NULL)
+        copy->pRight->refs.fetch_add(1, std::memory_order_relaxed);
+
+    release(n);
+    storeLink(link, copy);
+    return copy;
 }
 
 template <typename ElementType>
-AvlNode<ElementType> *AVLSet<ElementType>::cloneNode(AvlNode<ElementType> *t) const
+void AVLSet<ElementType>::unshareTree()
 {
-    if (t == NULL)
-        return NULL;
-    else
-        return new AvlNode(t->element, cloneNode(t->pLeft), cloneNode(t->pRight), t->deep, t->count);
+    std::vector<AvlNode<ElementType> **> pending;
+
+    if (this->root != NULL)
+        pending.push_back(&this->root);
+
+    while (!pending.empty())
+    {
+        AvlNode<ElementType> *n = unshare(*pending.back());
+        pending.pop_back();
+
+        if (n->pLeft != NULL)
+            pending.push_back(&n->pLeft);
+        if (n->pRight != NULL)
+            pending.push_back(&n->pRight);
+    }
 }
 
 #endif
@@ -80,6 +80,9 @@ public:
     virtual void add(const ElementType& element) override;
 
 
+    using Set<ElementType>::contains;
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function always runs in O(log n) time when
     // there are n elements in the AVL tree.
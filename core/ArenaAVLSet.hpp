@@ -0,0 +1,596 @@
+// ArenaAVLSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// An ArenaAVLSet is an AVL tree like AVLSet, balanced the same way, but
+// laid out to take as little memory as it can.  Rather than allocating
+// each node separately and linking them with pointers, nodes are
+// allocated from a SlabArena and linked to one another by 32-bit index,
+// and, as in HashSet, the characters of std::string elements are copied
+// back to back into one CharArena, so that a node stores only their
+// offset and length.  (A balanced tree would need only a byte for each
+// node's height, but an unbalanced one can be as tall as it is large; a
+// 32-bit height fits in what would otherwise be padding.)  A node holding
+// a std::string is 20 bytes, where an AvlNode is 72 (plus the heap block
+// each one is allocated in, plus another for any string too long to be
+// stored inside the std::string itself), and nodes added one after
+// another sit next to each other in memory.
+
+#ifndef ARENAAVLSET_HPP
+#define ARENAAVLSET_HPP
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "CharArena.hpp"
+#include "Set.hpp"
+#include "SlabArena.hpp"
+
+
+
+template <typename ElementType>
+class ArenaAVLSet : public Set<ElementType>
+{
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+public:
+    // Initializes an ArenaAVLSet to be empty, with or without balancing.
+    explicit ArenaAVLSet(bool shouldBalance = true);
+
+    ~ArenaAVLSet() noexcept override = default;
+    ArenaAVLSet(const ArenaAVLSet& s) = default;
+    ArenaAVLSet(ArenaAVLSet&& s) noexcept;
+    ArenaAVLSet& operator=(const ArenaAVLSet& s);
+    ArenaAVLSet& operator=(ArenaAVLSet&& s) noexcept;
+
+    bool isImplemented() const noexcept override;
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function always runs in
+    // O(log n) time when there are n elements in the AVL tree.
+    void add(const ElementType& element) override;
+
+    using Set<ElementType>::contains;
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function always runs in O(log n) time when
+    // there are n elements in the AVL tree.
+    bool contains(const ElementType& element) const override;
+    bool contains(std::string_view element) const override;
+
+    unsigned int size() const noexcept override;
+
+    // height() returns the height of the AVL tree.  Note that, by
+    // definition, the height of an empty tree is -1.
+    int height() const noexcept;
+
+    // preorder(), inorder(), and postorder() call the given "visit"
+    // function for each of the elements in the set, in the order
+    // determined by the corresponding traversal of the AVL tree.
+    void preorder(VisitFunction visit) const;
+    void inorder(VisitFunction visit) const;
+    void postorder(VisitFunction visit) const;
+
+    // bytes() returns the number of bytes occupied by the nodes' slabs and
+    // the stored characters.
+    unsigned long long bytes() const noexcept;
+
+
+private:
+    // A std::string element is stored as the offset and length of its
+    // characters in the CharArena; any other element is stored as-is.
+    struct StoredString
+    {
+        unsigned int offset;
+        unsigned int length;
+    };
+
+    static constexpr bool STORES_CHARS = std::is_same_v<ElementType, std::string>;
+
+    using StoredElement = std::conditional_t<STORES_CHARS, StoredString, ElementType>;
+
+    struct Node
+    {
+        StoredElement element;
+        unsigned int left;
+        unsigned int right;
+        unsigned int height;
+    };
+
+    // The index that marks a missing child (or an empty tree).
+    static constexpr unsigned int NO_NODE = UINT_MAX;
+
+    // add() records the path it follows on a fixed stack of this many
+    // entries, which is more than the height of any balanced tree with
+    // 2^32 nodes.  Only an unbalanced tree can outgrow it, in which case
+    // the heights along the rest of the path are found again by searching
+    // from the root.
+    static constexpr int MAX_PATH = 64;
+
+    SlabArena<Node> nodes;
+    CharArena chars;
+    unsigned int root;
+    bool shouldBalance;
+
+    // Returns a negative value, zero, or a positive value when the given
+    // element (an ElementType or a std::string_view) is less than, equal
+    // to, or greater than the element in the given node.
+    template <typename Key>
+    int compare(const Key& element, unsigned int node) const;
+
+    template <typename Key>
+    bool find(const Key& element) const;
+
+    int heightOf(unsigned int node) const noexcept;
+    void updateHeight(unsigned int node) noexcept;
+
+    // Each of these returns the index of the root of the subtree that
+    // replaces the one rooted at the given node.
+    unsigned int rotateWithLeftChild(unsigned int node) noexcept;
+    unsigned int rotateWithRightChild(unsigned int node) noexcept;
+    unsigned int rebalance(unsigned int node) noexcept;
+
+    // Allocates a node holding the given element and returns its index.
+    unsigned int allocateNode(const ElementType& element);
+
+    // When add()'s path doesn't fit on its stack, deepenPath() updates the
+    // heights along it instead.
+    void deepenPath(const ElementType& element, unsigned int added, int depth) noexcept;
+
+    void preorder(unsigned int node, const VisitFunction& visit) const;
+    void inorder(unsigned int node, const VisitFunction& visit) const;
+    void postorder(unsigned int node, const VisitFunction& visit) const;
+
+    // Returns the element stored in the given node, as an ElementType.
+    ElementType elementOf(unsigned int node) const;
+
+    void swap(ArenaAVLSet& s) noexcept;
+};
+
+
+
+template <typename ElementType>
+ArenaAVLSet<ElementType>::ArenaAVLSet(bool shouldBalance)
+    : root{NO_NODE}, shouldBalance{shouldBalance}
+{
+}
+
+
+template <typename ElementType>
+ArenaAVLSet<ElementType>::ArenaAVLSet(ArenaAVLSet&& s) noexcept
+    : root{NO_NODE}, shouldBalance{true}
+{
+    swap(s);
+}
+
+
+template <typename ElementType>
+ArenaAVLSet<ElementType>& ArenaAVLSet<ElementType>::operator=(const ArenaAVLSet& s)
+{
+    if (this != &s)
+    {
+        ArenaAVLSet copy{s};
+        swap(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+ArenaAVLSet<ElementType>& ArenaAVLSet<ElementType>::operator=(ArenaAVLSet&& s) noexcept
+{
+    swap(s);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool ArenaAVLSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::add(const ElementType& element)
+{
+    unsigned int path[MAX_PATH];
+    unsigned int n = root;
+    int depth = 0;
+    int comparison = 0;
+
+    while (n != NO_NODE)
+    {
+        comparison = compare(element, n);
+
+        if (comparison == 0)
+        {
+            return;
+        }
+
+        if (depth < MAX_PATH)
+        {
+            path[depth] = n;
+        }
+
+        depth++;
+        n = comparison < 0 ? nodes[n].left : nodes[n].right;
+    }
+
+    unsigned int added = allocateNode(element);
+
+    if (depth == 0)
+    {
+        root = added;
+        return;
+    }
+
+    if (depth > MAX_PATH)
+    {
+        // Only an unbalanced tree gets this deep, so there's nothing to
+        // rotate; the parent is found again by searching from the root.
+        deepenPath(element, added, depth);
+        return;
+    }
+
+    if (comparison < 0)
+    {
+        nodes[path[depth - 1]].left = added;
+    }
+    else
+    {
+        nodes[path[depth - 1]].right = added;
+    }
+
+    for (int i = depth - 1; i >= 0; --i)
+    {
+        unsigned int node = path[i];
+        int oldHeight = heightOf(node);
+        updateHeight(node);
+
+        unsigned int replacement = shouldBalance ? rebalance(node) : node;
+
+        if (replacement != node)
+        {
+            if (i == 0)
+            {
+                root = replacement;
+            }
+            else if (nodes[path[i - 1]].left == node)
+            {
+                nodes[path[i - 1]].left = replacement;
+            }
+            else
+            {
+                nodes[path[i - 1]].right = replacement;
+            }
+
+            // A rotation after an insertion restores the subtree's
+            // height, so nothing above it changes.
+            return;
+        }
+
+        if (heightOf(node) == oldHeight)
+        {
+            return;
+        }
+    }
+}
+
+
+template <typename ElementType>
+bool ArenaAVLSet<ElementType>::contains(const ElementType& element) const
+{
+    return find(element);
+}
+
+
+template <typename ElementType>
+bool ArenaAVLSet<ElementType>::contains(std::string_view element) const
+{
+    if constexpr (std::is_convertible_v<const ElementType&, std::string_view>)
+    {
+        return find(element);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+
+template <typename ElementType>
+unsigned int ArenaAVLSet<ElementType>::size() const noexcept
+{
+    return nodes.size();
+}
+
+
+template <typename ElementType>
+int ArenaAVLSet<ElementType>::height() const noexcept
+{
+    return heightOf(root);
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::preorder(VisitFunction visit) const
+{
+    preorder(root, visit);
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::inorder(VisitFunction visit) const
+{
+    inorder(root, visit);
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::postorder(VisitFunction visit) const
+{
+    postorder(root, visit);
+}
+
+
+template <typename ElementType>
+unsigned long long ArenaAVLSet<ElementType>::bytes() const noexcept
+{
+    return nodes.bytes() + chars.bytes();
+}
+
+
+template <typename ElementType>
+template <typename Key>
+int ArenaAVLSet<ElementType>::compare(const Key& element, unsigned int node) const
+{
+    if constexpr (STORES_CHARS)
+    {
+        const StoredString& stored = nodes[node].element;
+        return std::string_view{element}.compare(chars.view(stored.offset, stored.length));
+    }
+    else
+    {
+        const ElementType& stored = nodes[node].element;
+
+        if (element < stored)
+        {
+            return -1;
+        }
+        else if (stored < element)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+}
+
+
+template <typename ElementType>
+template <typename Key>
+bool ArenaAVLSet<ElementType>::find(const Key& element) const
+{
+    unsigned int n = root;
+
+    while (n != NO_NODE)
+    {
+        int comparison = compare(element, n);
+
+        if (comparison == 0)
+        {
+            return true;
+        }
+
+        n = comparison < 0 ? nodes[n].left : nodes[n].right;
+    }
+
+    return false;
+}
+
+
+template <typename ElementType>
+int ArenaAVLSet<ElementType>::heightOf(unsigned int node) const noexcept
+{
+    return node == NO_NODE ? -1 : nodes[node].height;
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::updateHeight(unsigned int node) noexcept
+{
+    nodes[node].height = static_cast<unsigned int>(
+        std::max(heightOf(nodes[node].left), heightOf(nodes[node].right)) + 1);
+}
+
+
+template <typename ElementType>
+unsigned int ArenaAVLSet<ElementType>::rotateWithLeftChild(unsigned int node) noexcept
+{
+    unsigned int child = nodes[node].left;
+    nodes[node].left = nodes[child].right;
+    nodes[child].right = node;
+
+    updateHeight(node);
+    updateHeight(child);
+    return child;
+}
+
+
+template <typename ElementType>
+unsigned int ArenaAVLSet<ElementType>::rotateWithRightChild(unsigned int node) noexcept
+{
+    unsigned int child = nodes[node].right;
+    nodes[node].right = nodes[child].left;
+    nodes[child].left = node;
+
+    updateHeight(node);
+    updateHeight(child);
+    return child;
+}
+
+
+template <typename ElementType>
+unsigned int ArenaAVLSet<ElementType>::rebalance(unsigned int node) noexcept
+{
+    int balance = heightOf(nodes[node].left) - heightOf(nodes[node].right);
+
+    if (balance > 1)
+    {
+        unsigned int left = nodes[node].left;
+
+        if (heightOf(nodes[left].left) < heightOf(nodes[left].right))
+        {
+            nodes[node].left = rotateWithRightChild(left);
+        }
+
+        return rotateWithLeftChild(node);
+    }
+    else if (balance < -1)
+    {
+        unsigned int right = nodes[node].right;
+
+        if (heightOf(nodes[right].right) < heightOf(nodes[right].left))
+        {
+            nodes[node].right = rotateWithLeftChild(right);
+        }
+
+        return rotateWithRightChild(node);
+    }
+    else
+    {
+        return node;
+    }
+}
+
+
+template <typename ElementType>
+unsigned int ArenaAVLSet<ElementType>::allocateNode(const ElementType& element)
+{
+    StoredElement stored;
+
+    if constexpr (STORES_CHARS)
+    {
+        stored = StoredString{
+            chars.append(element), static_cast<unsigned int>(element.length())};
+    }
+    else
+    {
+        stored = element;
+    }
+
+    return nodes.allocate(Node{stored, NO_NODE, NO_NODE, 0});
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::deepenPath(
+    const ElementType& element, unsigned int added, int depth) noexcept
+{
+    // Without balancing, every node on the path to the new one at the
+    // given depth is at least as tall as the distance down to it.
+    unsigned int n = root;
+
+    for (int d = 0; ; ++d)
+    {
+        nodes[n].height = std::max(nodes[n].height, static_cast<unsigned int>(depth - d));
+
+        if (compare(element, n) < 0)
+        {
+            if (nodes[n].left == NO_NODE)
+            {
+                nodes[n].left = added;
+                return;
+            }
+
+            n = nodes[n].left;
+        }
+        else
+        {
+            if (nodes[n].right == NO_NODE)
+            {
+                nodes[n].right = added;
+                return;
+            }
+
+            n = nodes[n].right;
+        }
+    }
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::preorder(unsigned int node, const VisitFunction& visit) const
+{
+    if (node != NO_NODE)
+    {
+        visit(elementOf(node));
+        preorder(nodes[node].left, visit);
+        preorder(nodes[node].right, visit);
+    }
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::inorder(unsigned int node, const VisitFunction& visit) const
+{
+    if (node != NO_NODE)
+    {
+        inorder(nodes[node].left, visit);
+        visit(elementOf(node));
+        inorder(nodes[node].right, visit);
+    }
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::postorder(unsigned int node, const VisitFunction& visit) const
+{
+    if (node != NO_NODE)
+    {
+        postorder(nodes[node].left, visit);
+        postorder(nodes[node].right, visit);
+        visit(elementOf(node));
+    }
+}
+
+
+template <typename ElementType>
+ElementType ArenaAVLSet<ElementType>::elementOf(unsigned int node) const
+{
+    if constexpr (STORES_CHARS)
+    {
+        const StoredString& stored = nodes[node].element;
+        return std::string{chars.view(stored.offset, stored.length)};
+    }
+    else
+    {
+        return nodes[node].element;
+    }
+}
+
+
+template <typename ElementType>
+void ArenaAVLSet<ElementType>::swap(ArenaAVLSet& s) noexcept
+{
+    nodes.swap(s.nodes);
+    chars.swap(s.chars);
+    std::swap(root, s.root);
+    std::swap(shouldBalance, s.shouldBalance);
+}
+
+
+
+#endif
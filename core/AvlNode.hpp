@@ -0,0 +1,63 @@
+#ifndef AVLNODE_HPP
+#define AVLNODE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace impl_
+{
+    // Packs the first eight characters of the given string (padded with
+    // zeroes) into an integer, first character highest, so that whenever
+    // two strings' prefixes differ, comparing them as unsigned integers
+    // orders them the same way comparing the strings would.
+    inline std::uint64_t AvlNode__prefixOf(std::string_view element) noexcept
+    {
+        std::uint64_t prefix = 0;
+
+        for (std::size_t i = 0; i < 8 && i < element.length(); ++i)
+            prefix |= static_cast<std::uint64_t>(static_cast<unsigned char>(element[i])) << (56 - 8 * i);
+
+        return prefix;
+    }
+}
+
+template<typename T>
+class AvlNode
+{
+    T element;
+    AvlNode *pLeft;
+    AvlNode *pRight;
+    // For string elements, the element's first eight characters, packed by
+    // impl_::AvlNode__prefixOf(), so that most comparisons during a search
+    // are settled without reading the element's characters; otherwise, 0.
+    std::uint64_t prefix;
+    int deep;
+    int count;
+    // The number of parents and AVLSets referring to this node; a node is
+    // shared between copies of a set whenever this is more than 1.
+    std::atomic<int> refs;
+    // Bumped to an odd number just before a rotation moves this node down
+    // (shrinking the range of elements below it) and to the next even
+    // number just after, so that a reader passing through without a lock
+    // can tell whether the node changed under it.
+    std::atomic<unsigned int> version;
+    AvlNode(const T & theElement, AvlNode *init_left, AvlNode *init_right, int init_deep = 0, int init_cnt = 0)
+        : element(theElement), pLeft(init_left), pRight(init_right), prefix(prefixOf(theElement)),
+          deep(init_deep), count(init_cnt), refs(1), version(0) {}
+
+    static std::uint64_t prefixOf(const T & theElement) noexcept
+    {
+        if constexpr (std::is_convertible_v<const T &, std::string_view>)
+            return impl_::AvlNode__prefixOf(theElement);
+        else
+            return 0;
+    }
+
+    template<typename ElementType>
+    friend class AVLSet;
+};
+
+#endif
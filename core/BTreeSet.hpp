@@ -0,0 +1,814 @@
+// BTreeSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BTreeSet is a B-tree whose nodes are each exactly two cache lines
+// (128 bytes) long, so that a search misses the cache about twice per
+// level rather than once per element it compares against.  A node holds
+// up to seven keys, along with one more child than it has keys.  Each key
+// is stored as the index (or, for a string, the offset) of the element it
+// stands for, alongside (for std::string elements) the element's first
+// eight characters, packed by impl_::AvlNode__prefixOf(); the prefixes
+// fill the node's first cache line, and the position of a key among them
+// is found by comparing all of them at once with SSE2 instructions, so
+// that the elements themselves are only consulted when their prefixes
+// tie.  As in ArenaAVLSet, nodes are allocated from a SlabArena and
+// linked by index, and the characters of std::string elements are copied
+// back to back into one CharArena; each is preceded there by its length,
+// so that a key can simply be the offset of the length, and reaching a
+// string from a node costs a single cache miss.
+//
+// Elements added one at a time are inserted into a leaf, splitting any
+// node that overflows on the way back up; addSorted() instead builds the
+// whole tree bottom-up from a sorted range in linear time.
+
+#ifndef BTREESET_HPP
+#define BTREESET_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "AvlNode.hpp"
+#include "CharArena.hpp"
+#include "Set.hpp"
+#include "SlabArena.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+
+template <typename ElementType>
+class BTreeSet : public Set<ElementType>
+{
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+    // The most keys a node can hold.
+    static constexpr unsigned int KEYS_PER_NODE = 7;
+
+public:
+    // Initializes a BTreeSet to be empty.
+    BTreeSet();
+
+    ~BTreeSet() noexcept override = default;
+    BTreeSet(const BTreeSet& s) = default;
+    BTreeSet(BTreeSet&& s) noexcept;
+    BTreeSet& operator=(const BTreeSet& s);
+    BTreeSet& operator=(BTreeSet&& s) noexcept;
+
+    bool isImplemented() const noexcept override;
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function always runs in
+    // O(log n) time when there are n elements in the B-tree.
+    void add(const ElementType& element) override;
+
+    using Set<ElementType>::contains;
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function always runs in O(log n) time when
+    // there are n elements in the B-tree.
+    bool contains(const ElementType& element) const override;
+    bool contains(std::string_view element) const override;
+
+    unsigned int size() const noexcept override;
+
+    // addSorted() adds every element in the range [begin, end), which is
+    // expected to be in ascending order (duplicates are allowed).  When
+    // the set is empty, the tree is built bottom-up in O(m) time, where m
+    // is the length of the range, with every leaf at the same depth and
+    // no node split along the way; otherwise, the elements are added one
+    // at a time.  If the range turns out not to be sorted, a sorted copy
+    // of it is added instead.
+    template <typename Iterator>
+    void addSorted(Iterator begin, Iterator end);
+
+    // height() returns the height of the B-tree: the number of levels
+    // below the root.  By definition, the height of an empty tree is -1.
+    int height() const noexcept;
+
+    // inorder() calls the given "visit" function for each of the elements
+    // in the set, in ascending order.
+    void inorder(VisitFunction visit) const;
+
+    // bytes() returns the number of bytes occupied by the nodes' slabs and
+    // the stored elements.
+    unsigned long long bytes() const noexcept;
+
+
+private:
+    // A std::string element is stored in the CharArena, as its length
+    // followed by its characters, and its key is the offset of the length;
+    // any other element is stored as-is in a SlabArena, and its key is its
+    // index there.
+    static constexpr bool STORES_CHARS = std::is_same_v<ElementType, std::string>;
+
+    // The prefixes of the keys, in ascending order, fill the first cache
+    // line, each split into its high and low halves, since SSE2 compares
+    // 32-bit lanes; the slots past the last key (including the eighth,
+    // which is never used) hold NO_PREFIX, which no key's prefix is less
+    // than.  For elements that aren't strings, every prefix is 0, so every
+    // key ties and is compared in full.
+    struct alignas(64) Node
+    {
+        std::uint32_t highs[KEYS_PER_NODE + 1];
+        std::uint32_t lows[KEYS_PER_NODE + 1];
+        unsigned int keys[KEYS_PER_NODE];
+        unsigned int children[KEYS_PER_NODE + 1];
+        std::uint16_t count;
+        bool leaf;
+    };
+
+    static_assert(sizeof(Node) == 128, "a BTreeSet node should be two cache lines long");
+
+    // What insert() hands back to a node's parent: whether the node had to
+    // be split and, if so, the key that moves up into the parent and the
+    // index of the new node holding the keys that followed it.
+    struct Split
+    {
+        bool happened;
+        std::uint64_t prefix;
+        unsigned int key;
+        unsigned int right;
+    };
+
+    // The index that marks a missing child (or an empty tree).
+    static constexpr unsigned int NO_NODE = UINT_MAX;
+
+    static constexpr std::uint64_t NO_PREFIX = UINT64_MAX;
+
+    SlabArena<Node> nodes;
+    SlabArena<ElementType> values;
+    CharArena chars;
+    unsigned int count;
+    unsigned int root;
+
+    template <typename Key>
+    static std::uint64_t prefixOf(const Key& element) noexcept;
+
+    static std::uint64_t prefixAt(const Node& node, unsigned int position) noexcept;
+    static void setPrefix(Node& node, unsigned int position, std::uint64_t prefix) noexcept;
+
+    // Returns the number of the given node's prefixes that are less than
+    // the given one.
+    static unsigned int countLess(const Node& node, std::uint64_t prefix) noexcept;
+
+    // Replaces the given node's keys (and their prefixes) and children
+    // with the given ones.
+    static void setKeys(
+        Node& node, const std::uint64_t* prefixes, const unsigned int* keys,
+        const unsigned int* children, unsigned int count) noexcept;
+
+    // Returns a negative value, zero, or a positive value when the given
+    // element (an ElementType or a std::string_view) is less than, equal
+    // to, or greater than the stored element with the given key.
+    template <typename Key>
+    int compare(const Key& element, unsigned int key) const;
+
+    // Returns the position of the first key in the given node that isn't
+    // less than the given element, setting found to whether it's equal.
+    template <typename Key>
+    unsigned int search(
+        const Node& node, const Key& element, std::uint64_t elementPrefix, bool& found) const;
+
+    template <typename Key>
+    bool find(const Key& element) const;
+
+    unsigned int newNode(bool leaf);
+    // Stores the given element, returning its key.
+    unsigned int store(const ElementType& element);
+
+    Split insert(unsigned int node, const ElementType& element, std::uint64_t elementPrefix);
+
+    // Puts the given key (and the child that follows it) at the given
+    // position in the given node, splitting the node if it's full.
+    Split insertAt(
+        unsigned int node, unsigned int position,
+        std::uint64_t prefix, unsigned int key, unsigned int right);
+
+    // Builds a subtree of the given height holding the elements with the
+    // given keys, in [first, first + count), returning the index of its
+    // root.
+    unsigned int build(
+        const std::vector<unsigned int>& keys, unsigned int first, unsigned int count, int height);
+
+    void inorder(unsigned int node, const VisitFunction& visit) const;
+
+    // Returns the characters of the std::string element with the given key.
+    std::string_view charsOf(unsigned int key) const noexcept;
+
+    // Returns the stored element with the given key, as an ElementType.
+    ElementType elementOf(unsigned int key) const;
+
+    // Returns the prefix of the stored element with the given key.
+    std::uint64_t storedPrefix(unsigned int key) const noexcept;
+
+    void swap(BTreeSet& s) noexcept;
+};
+
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::BTreeSet()
+    : count{0}, root{NO_NODE}
+{
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>::BTreeSet(BTreeSet&& s) noexcept
+    : count{0}, root{NO_NODE}
+{
+    swap(s);
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>& BTreeSet<ElementType>::operator=(const BTreeSet& s)
+{
+    if (this != &s)
+    {
+        BTreeSet copy{s};
+        swap(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+BTreeSet<ElementType>& BTreeSet<ElementType>::operator=(BTreeSet&& s) noexcept
+{
+    swap(s);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool BTreeSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::add(const ElementType& element)
+{
+    if (root == NO_NODE)
+    {
+        root = newNode(true);
+    }
+
+    Split split = insert(root, element, prefixOf(element));
+
+    if (split.happened)
+    {
+        unsigned int newRoot = newNode(false);
+        Node& n = nodes[newRoot];
+        setPrefix(n, 0, split.prefix);
+        n.keys[0] = split.key;
+        n.children[0] = root;
+        n.children[1] = split.right;
+        n.count = 1;
+
+        root = newRoot;
+    }
+}
+
+
+template <typename ElementType>
+bool BTreeSet<ElementType>::contains(const ElementType& element) const
+{
+    return find(element);
+}
+
+
+template <typename ElementType>
+bool BTreeSet<ElementType>::contains(std::string_view element) const
+{
+    if constexpr (std::is_convertible_v<const ElementType&, std::string_view>)
+    {
+        return find(element);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename ElementType>
+template <typename Iterator>
+void BTreeSet<ElementType>::addSorted(Iterator begin, Iterator end)
+{
+    if (!std::is_sorted(begin, end))
+    {
+        std::vector<ElementType> sorted{begin, end};
+        std::sort(sorted.begin(), sorted.end());
+        addSorted(sorted.begin(), sorted.end());
+        return;
+    }
+
+    if (root != NO_NODE)
+    {
+        for (; begin != end; ++begin)
+        {
+            add(*begin);
+        }
+
+        return;
+    }
+
+    std::vector<unsigned int> keys;
+
+    for (Iterator i = begin; i != end; ++i)
+    {
+        if (i == begin || *std::prev(i) < *i)
+        {
+            keys.push_back(store(*i));
+        }
+    }
+
+    if (keys.empty())
+    {
+        return;
+    }
+
+    // A tree of height h holds at most (KEYS_PER_NODE + 1)^(h + 1) - 1
+    // keys; build the shortest one that holds them all.
+    int height = 0;
+
+    for (unsigned long long capacity = KEYS_PER_NODE; capacity < keys.size();
+         capacity = capacity * (KEYS_PER_NODE + 1) + KEYS_PER_NODE)
+    {
+        ++height;
+    }
+
+    root = build(keys, 0, static_cast<unsigned int>(keys.size()), height);
+}
+
+
+template <typename ElementType>
+int BTreeSet<ElementType>::height() const noexcept
+{
+    int height = -1;
+
+    for (unsigned int n = root; n != NO_NODE; n = nodes[n].children[0])
+    {
+        ++height;
+    }
+
+    return height;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::inorder(VisitFunction visit) const
+{
+    inorder(root, visit);
+}
+
+
+template <typename ElementType>
+unsigned long long BTreeSet<ElementType>::bytes() const noexcept
+{
+    return nodes.bytes() + values.bytes() + chars.bytes();
+}
+
+
+template <typename ElementType>
+template <typename Key>
+std::uint64_t BTreeSet<ElementType>::prefixOf(const Key& element) noexcept
+{
+    if constexpr (STORES_CHARS)
+    {
+        return impl_::AvlNode__prefixOf(element);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+
+template <typename ElementType>
+std::uint64_t BTreeSet<ElementType>::prefixAt(const Node& node, unsigned int position) noexcept
+{
+    return static_cast<std::uint64_t>(node.highs[position]) << 32 | node.lows[position];
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::setPrefix(
+    Node& node, unsigned int position, std::uint64_t prefix) noexcept
+{
+    node.highs[position] = static_cast<std::uint32_t>(prefix >> 32);
+    node.lows[position] = static_cast<std::uint32_t>(prefix);
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::countLess(const Node& node, std::uint64_t prefix) noexcept
+{
+#ifdef __SSE2__
+    // SSE2 compares signed lanes, so every half has its sign bit flipped
+    // first, which turns an unsigned comparison into a signed one.  A
+    // prefix is less than the given one when its high half is, or when
+    // the high halves are equal and its low half is.
+    const __m128i bias = _mm_set1_epi32(INT_MIN);
+    const __m128i high = _mm_xor_si128(
+        _mm_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(prefix >> 32))), bias);
+    const __m128i low = _mm_xor_si128(
+        _mm_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(prefix))), bias);
+
+    __m128i less[2];
+
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        __m128i highs = _mm_xor_si128(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(node.highs + 4 * i)), bias);
+        __m128i lows = _mm_xor_si128(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(node.lows + 4 * i)), bias);
+
+        less[i] = _mm_or_si128(
+            _mm_cmpgt_epi32(high, highs),
+            _mm_and_si128(_mm_cmpeq_epi32(high, highs), _mm_cmpgt_epi32(low, lows)));
+    }
+
+    // Narrowing the eight lanes to bytes yields one bit per prefix; since
+    // the prefixes are in ascending order, the ones that are less come
+    // first, so counting them is counting the trailing 1 bits.
+    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(
+        _mm_packs_epi16(_mm_packs_epi32(less[0], less[1]), _mm_setzero_si128())));
+
+    return static_cast<unsigned int>(__builtin_ctz(~mask));
+#else
+    unsigned int less = 0;
+
+    for (unsigned int i = 0; i < KEYS_PER_NODE + 1; ++i)
+    {
+        less += prefixAt(node, i) < prefix;
+    }
+
+    return less;
+#endif
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::setKeys(
+    Node& node, const std::uint64_t* prefixes, const unsigned int* keys,
+    const unsigned int* children, unsigned int count) noexcept
+{
+    for (unsigned int i = 0; i < KEYS_PER_NODE + 1; ++i)
+    {
+        setPrefix(node, i, i < count ? prefixes[i] : NO_PREFIX);
+        node.children[i] = i <= count ? children[i] : NO_NODE;
+    }
+
+    std::copy(keys, keys + count, node.keys);
+    node.count = static_cast<std::uint16_t>(count);
+}
+
+
+template <typename ElementType>
+template <typename Key>
+int BTreeSet<ElementType>::compare(const Key& element, unsigned int key) const
+{
+    if constexpr (STORES_CHARS)
+    {
+        return std::string_view{element}.compare(charsOf(key));
+    }
+    else
+    {
+        const ElementType& s = values[key];
+
+        if (element < s)
+        {
+            return -1;
+        }
+        else if (s < element)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+}
+
+
+template <typename ElementType>
+template <typename Key>
+unsigned int BTreeSet<ElementType>::search(
+    const Node& node, const Key& element, std::uint64_t elementPrefix, bool& found) const
+{
+    unsigned int position = countLess(node, elementPrefix);
+
+    for (; position < node.count && prefixAt(node, position) == elementPrefix; ++position)
+    {
+        int comparison = compare(element, node.keys[position]);
+
+        if (comparison <= 0)
+        {
+            found = comparison == 0;
+            return position;
+        }
+    }
+
+    found = false;
+    return position;
+}
+
+
+template <typename ElementType>
+template <typename Key>
+bool BTreeSet<ElementType>::find(const Key& element) const
+{
+    std::uint64_t elementPrefix = prefixOf(element);
+    unsigned int n = root;
+
+    while (n != NO_NODE)
+    {
+        const Node& node = nodes[n];
+
+        // The prefixes are compared first, but the child to follow is in
+        // the second cache line, so ask for it now.
+        __builtin_prefetch(node.children);
+
+        bool found;
+        unsigned int position = search(node, element, elementPrefix, found);
+
+        if (found)
+        {
+            return true;
+        }
+
+        n = node.children[position];
+    }
+
+    return false;
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::newNode(bool leaf)
+{
+    Node n;
+    std::fill(std::begin(n.highs), std::end(n.highs), UINT32_MAX);
+    std::fill(std::begin(n.lows), std::end(n.lows), UINT32_MAX);
+    std::fill(std::begin(n.keys), std::end(n.keys), 0);
+    std::fill(std::begin(n.children), std::end(n.children), NO_NODE);
+    n.count = 0;
+    n.leaf = leaf;
+
+    return nodes.allocate(n);
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::store(const ElementType& element)
+{
+    ++count;
+
+    if constexpr (STORES_CHARS)
+    {
+        unsigned int length = static_cast<unsigned int>(element.length());
+
+        return chars.append(
+            std::string_view{reinterpret_cast<const char*>(&length), sizeof(length)}, element);
+    }
+    else
+    {
+        return values.allocate(element);
+    }
+}
+
+
+template <typename ElementType>
+typename BTreeSet<ElementType>::Split BTreeSet<ElementType>::insert(
+    unsigned int node, const ElementType& element, std::uint64_t elementPrefix)
+{
+    bool found;
+    unsigned int position = search(nodes[node], element, elementPrefix, found);
+
+    if (found)
+    {
+        return Split{false, 0, 0, NO_NODE};
+    }
+    else if (nodes[node].leaf)
+    {
+        return insertAt(node, position, elementPrefix, store(element), NO_NODE);
+    }
+
+    Split below = insert(nodes[node].children[position], element, elementPrefix);
+
+    if (!below.happened)
+    {
+        return below;
+    }
+
+    return insertAt(node, position, below.prefix, below.key, below.right);
+}
+
+
+template <typename ElementType>
+typename BTreeSet<ElementType>::Split BTreeSet<ElementType>::insertAt(
+    unsigned int node, unsigned int position,
+    std::uint64_t prefix, unsigned int key, unsigned int right)
+{
+    Node& n = nodes[node];
+
+    // Lay out all of the node's keys and children, with the new ones among
+    // them; if there are too many keys, the middle one moves up to the
+    // parent, and the ones after it into a new node.
+    std::uint64_t prefixes[KEYS_PER_NODE + 1];
+    unsigned int keys[KEYS_PER_NODE + 1];
+    unsigned int children[KEYS_PER_NODE + 2];
+
+    for (unsigned int i = 0; i < n.count; ++i)
+    {
+        unsigned int to = i < position ? i : i + 1;
+        prefixes[to] = prefixAt(n, i);
+        keys[to] = n.keys[i];
+    }
+
+    prefixes[position] = prefix;
+    keys[position] = key;
+
+    std::copy(n.children, n.children + position + 1, children);
+    std::copy(n.children + position + 1, n.children + n.count + 1, children + position + 2);
+    children[position + 1] = right;
+
+    unsigned int total = n.count + 1u;
+
+    if (total <= KEYS_PER_NODE)
+    {
+        setKeys(n, prefixes, keys, children, total);
+        return Split{false, 0, 0, NO_NODE};
+    }
+
+    constexpr unsigned int MIDDLE = (KEYS_PER_NODE + 1) / 2;
+
+    unsigned int sibling = newNode(n.leaf);
+
+    setKeys(n, prefixes, keys, children, MIDDLE);
+    setKeys(
+        nodes[sibling], prefixes + MIDDLE + 1, keys + MIDDLE + 1, children + MIDDLE + 1,
+        total - MIDDLE - 1);
+
+    return Split{true, prefixes[MIDDLE], keys[MIDDLE], sibling};
+}
+
+
+template <typename ElementType>
+unsigned int BTreeSet<ElementType>::build(
+    const std::vector<unsigned int>& keys, unsigned int first, unsigned int count, int height)
+{
+    unsigned int node = newNode(height == 0);
+
+    if (height == 0)
+    {
+        Node& n = nodes[node];
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            n.keys[i] = keys[first + i];
+            setPrefix(n, i, storedPrefix(keys[first + i]));
+        }
+
+        n.count = static_cast<std::uint16_t>(count);
+        return node;
+    }
+
+    // Each child is a subtree of height - 1, holding at most subtreeKeys
+    // keys; use as few children as will hold them, spreading the keys
+    // evenly among them, so that no subtree ends up too small to fill out
+    // its own height.
+    unsigned long long subtreeKeys = KEYS_PER_NODE;
+
+    for (int h = 1; h < height; ++h)
+    {
+        subtreeKeys = subtreeKeys * (KEYS_PER_NODE + 1) + KEYS_PER_NODE;
+    }
+
+    unsigned int childCount = std::max(
+        2u, static_cast<unsigned int>((count + 1 + subtreeKeys) / (subtreeKeys + 1)));
+
+    unsigned int childKeys = count - (childCount - 1);
+    unsigned int next = first;
+
+    for (unsigned int i = 0; i < childCount; ++i)
+    {
+        unsigned int keysBelow = childKeys / childCount + (i < childKeys % childCount ? 1 : 0);
+        unsigned int child = build(keys, next, keysBelow, height - 1);
+        next += keysBelow;
+
+        Node& n = nodes[node];
+        n.children[i] = child;
+
+        if (i + 1 < childCount)
+        {
+            n.keys[i] = keys[next];
+            setPrefix(n, i, storedPrefix(keys[next]));
+            ++next;
+        }
+    }
+
+    nodes[node].count = static_cast<std::uint16_t>(childCount - 1);
+    return node;
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::inorder(unsigned int node, const VisitFunction& visit) const
+{
+    if (node == NO_NODE)
+    {
+        return;
+    }
+
+    const Node& n = nodes[node];
+
+    for (unsigned int i = 0; i < n.count; ++i)
+    {
+        inorder(n.children[i], visit);
+        visit(elementOf(n.keys[i]));
+    }
+
+    inorder(n.children[n.count], visit);
+}
+
+
+template <typename ElementType>
+std::string_view BTreeSet<ElementType>::charsOf(unsigned int key) const noexcept
+{
+    unsigned int length;
+    std::memcpy(&length, chars.view(key, sizeof(length)).data(), sizeof(length));
+
+    return chars.view(key, sizeof(length) + length).substr(sizeof(length));
+}
+
+
+template <typename ElementType>
+ElementType BTreeSet<ElementType>::elementOf(unsigned int key) const
+{
+    if constexpr (STORES_CHARS)
+    {
+        return std::string{charsOf(key)};
+    }
+    else
+    {
+        return values[key];
+    }
+}
+
+
+template <typename ElementType>
+std::uint64_t BTreeSet<ElementType>::storedPrefix(unsigned int key) const noexcept
+{
+    if constexpr (STORES_CHARS)
+    {
+        return impl_::AvlNode__prefixOf(charsOf(key));
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+
+template <typename ElementType>
+void BTreeSet<ElementType>::swap(BTreeSet& s) noexcept
+{
+    nodes.swap(s.nodes);
+    values.swap(s.values);
+    chars.swap(s.chars);
+    std::swap(count, s.count);
+    std::swap(root, s.root);
+}
+
+
+
+#endif
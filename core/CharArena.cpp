@@ -0,0 +1,174 @@
+// CharArena.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <utility>
+#include "CharArena.hpp"
+
+
+
+CharArena::CharArena() noexcept
+    : chunks{nullptr}, chunkCount{0}, chunkCapacity{0}, stored{0}
+{
+}
+
+
+CharArena::~CharArena() noexcept
+{
+    release();
+}
+
+
+CharArena::CharArena(const CharArena& a)
+    : CharArena{}
+{
+    if (a.chunkCount == 0)
+    {
+        return;
+    }
+
+    chunks = new Chunk[a.chunkCount];
+    chunkCapacity = a.chunkCount;
+
+    // Each chunk of the copy is only as large as what's stored in it, so
+    // the next append() starts a new chunk.
+    try
+    {
+        for (; chunkCount < a.chunkCount; ++chunkCount)
+        {
+            const Chunk& chunk = a.chunks[chunkCount];
+            chunks[chunkCount] = Chunk{new char[chunk.used], chunk.used, chunk.used};
+            std::copy(chunk.chars, chunk.chars + chunk.used, chunks[chunkCount].chars);
+        }
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+
+    stored = a.stored;
+}
+
+
+CharArena::CharArena(CharArena&& a) noexcept
+    : CharArena{}
+{
+    swap(a);
+}
+
+
+CharArena& CharArena::operator=(const CharArena& a)
+{
+    if (this != &a)
+    {
+        CharArena copy{a};
+        swap(copy);
+    }
+
+    return *this;
+}
+
+
+CharArena& CharArena::operator=(CharArena&& a) noexcept
+{
+    swap(a);
+    return *this;
+}
+
+
+unsigned int CharArena::append(std::string_view s)
+{
+    return append(s, std::string_view{});
+}
+
+
+unsigned int CharArena::append(std::string_view first, std::string_view second)
+{
+    unsigned int length = first.length() + second.length();
+
+    if (chunkCount == 0 || chunks[chunkCount - 1].used + length > chunks[chunkCount - 1].capacity)
+    {
+        addChunk(std::max(CHUNK_SIZE, length));
+    }
+
+    Chunk& chunk = chunks[chunkCount - 1];
+    unsigned int offset = ((chunkCount - 1) << POSITION_BITS) | chunk.used;
+
+    char* end = std::copy(first.begin(), first.end(), chunk.chars + chunk.used);
+    std::copy(second.begin(), second.end(), end);
+    chunk.used += length;
+    stored += length;
+
+    return offset;
+}
+
+
+std::string_view CharArena::view(unsigned int offset, unsigned int length) const noexcept
+{
+    const Chunk& chunk = chunks[offset >> POSITION_BITS];
+    return std::string_view{chunk.chars + (offset & (CHUNK_SIZE - 1)), length};
+}
+
+
+unsigned int CharArena::size() const noexcept
+{
+    return stored;
+}
+
+
+unsigned long long CharArena::bytes() const noexcept
+{
+    unsigned long long bytes = 0;
+
+    for (unsigned int i = 0; i < chunkCount; ++i)
+    {
+        bytes += chunks[i].capacity;
+    }
+
+    return bytes;
+}
+
+
+void CharArena::swap(CharArena& a) noexcept
+{
+    std::swap(chunks, a.chunks);
+    std::swap(chunkCount, a.chunkCount);
+    std::swap(chunkCapacity, a.chunkCapacity);
+    std::swap(stored, a.stored);
+}
+
+
+void CharArena::addChunk(unsigned int capacity)
+{
+    if (chunkCount == chunkCapacity)
+    {
+        unsigned int newChunkCapacity = chunkCapacity == 0 ? 4 : chunkCapacity * 2;
+        Chunk* newChunks = new Chunk[newChunkCapacity];
+        std::copy(chunks, chunks + chunkCount, newChunks);
+
+        delete[] chunks;
+        chunks = newChunks;
+        chunkCapacity = newChunkCapacity;
+    }
+
+    chunks[chunkCount] = Chunk{new char[capacity], capacity, 0};
+    ++chunkCount;
+}
+
+
+void CharArena::release() noexcept
+{
+    for (unsigned int i = 0; i < chunkCount; ++i)
+    {
+        delete[] chunks[i].chars;
+    }
+
+    delete[] chunks;
+    chunks = nullptr;
+    chunkCount = 0;
+    chunkCapacity = 0;
+    stored = 0;
+}
@@ -0,0 +1,87 @@
+// CharArena.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A CharArena is an append-only store of characters.  Strings copied into
+// it are laid out back to back in a sequence of fixed-size "chunks," each
+// a dynamically-allocated array of CHUNK_SIZE characters, and referred to
+// by their offset and length.  A string that doesn't fit in what's left of
+// the last chunk starts a new one (or, if it's longer than CHUNK_SIZE, is
+// given a chunk of its own), so every string is stored contiguously, and
+// nothing ever moves once it's stored; enlarging the arena never copies
+// the characters already in it.  Nothing is ever removed; all of the
+// chunks are released together.
+//
+// An offset encodes both the chunk and the position within it, so it
+// should be treated as opaque: the only way to find a string's characters
+// is to pass its offset to view().
+
+#ifndef CHARARENA_HPP
+#define CHARARENA_HPP
+
+#include <string_view>
+
+
+
+class CharArena
+{
+public:
+    // The number of bits of an offset that hold the position within a
+    // chunk; the rest hold the index of the chunk.
+    static constexpr unsigned int POSITION_BITS = 14;
+
+    // The number of characters in each chunk.
+    static constexpr unsigned int CHUNK_SIZE = 1u << POSITION_BITS;
+
+public:
+    CharArena() noexcept;
+    ~CharArena() noexcept;
+    CharArena(const CharArena& a);
+    CharArena(CharArena&& a) noexcept;
+    CharArena& operator=(const CharArena& a);
+    CharArena& operator=(CharArena&& a) noexcept;
+
+    // append() copies the given characters into the arena and returns the
+    // offset at which they were stored.
+    unsigned int append(std::string_view chars);
+
+    // append() can also copy two strings back to back (such as a length
+    // and the characters it describes), returning the offset of the first.
+    // Both are stored in the same chunk, so they can be viewed together.
+    unsigned int append(std::string_view first, std::string_view second);
+
+    // view() returns the given number of characters stored at the given
+    // offset, which can be fewer than were appended there.
+    std::string_view view(unsigned int offset, unsigned int length) const noexcept;
+
+    // size() returns the number of characters stored in the arena.
+    unsigned int size() const noexcept;
+
+    // bytes() returns the number of bytes occupied by the chunks.
+    unsigned long long bytes() const noexcept;
+
+    void swap(CharArena& a) noexcept;
+
+private:
+    struct Chunk
+    {
+        char* chars;
+        unsigned int capacity;
+        unsigned int used;
+    };
+
+    Chunk* chunks;
+    unsigned int chunkCount;
+    unsigned int chunkCapacity;
+    unsigned int stored;
+
+    // Adds an empty chunk of the given capacity to the end of the arena.
+    void addChunk(unsigned int capacity);
+
+    void release() noexcept;
+};
+
+
+
+#endif
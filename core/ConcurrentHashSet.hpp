@@ -0,0 +1,443 @@
+// ConcurrentHashSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentHashSet is a separately-chained hash table, like HashSet,
+// that any number of threads can search with contains() while another
+// thread is adding elements to it.
+//
+// Readers never take a lock and never retry: a lookup announces itself to
+// EpochReclamation, follows the current table's chain for its element, and
+// leaves.  Writers are serialized by a mutex.  Nodes are never modified
+// once a reader could see them; a new element is added by building its
+// node (pointing at the current head of its chain) and then publishing it
+// as the new head with a release store, so a reader either sees the fully
+// built node or the chain as it was.
+//
+// When the ratio of size to capacity would exceed 0.8, the writer builds a
+// complete new table of capacity * 2 + 1 (with new nodes, since relinking
+// the old ones would change chains out from under readers) and publishes
+// it in one store.  The old table is retired and deleted once no reader
+// that might still be walking it remains, as determined by
+// EpochReclamation.
+//
+// Copying, moving, assigning, and destroying a ConcurrentHashSet must not
+// happen while other threads are using it.
+
+#ifndef CONCURRENTHASHSET_HPP
+#define CONCURRENTHASHSET_HPP
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "EpochReclamation.hpp"
+#include "Set.hpp"
+
+
+
+template <typename ElementType, typename Hasher = std::function<unsigned int(const ElementType&)>>
+class ConcurrentHashSet : public Set<ElementType>
+{
+public:
+    // The default capacity of the ConcurrentHashSet before anything has
+    // been added to it.
+    static constexpr unsigned int DEFAULT_CAPACITY = 10;
+
+    // As in HashSet, the hash function is a std::function by default, but
+    // can be any function object type.
+    using HashFunction = Hasher;
+
+public:
+    explicit ConcurrentHashSet(HashFunction hashFunction);
+    ~ConcurrentHashSet() noexcept override;
+    ConcurrentHashSet(const ConcurrentHashSet& s);
+    ConcurrentHashSet(ConcurrentHashSet&& s) noexcept;
+    ConcurrentHashSet& operator=(const ConcurrentHashSet& s);
+    ConcurrentHashSet& operator=(ConcurrentHashSet&& s) noexcept;
+
+    bool isImplemented() const noexcept override;
+
+    // add() adds an element to the set, waiting for any other add() that
+    // is underway to finish first.  It can run concurrently with any
+    // number of calls to contains().
+    void add(const ElementType& element) override;
+
+    using Set<ElementType>::contains;
+
+    // contains() returns true if the given element was in the set at some
+    // point during the call, false otherwise.  It never blocks, and runs in
+    // time proportional to the length of one chain.
+    bool contains(const ElementType& element) const override;
+    bool contains(std::string_view element) const override;
+
+    unsigned int size() const noexcept override;
+
+    // capacity() returns the capacity of the current table.
+    unsigned int capacity() const noexcept;
+
+    // retiredTables() returns the number of replaced tables that are still
+    // waiting for readers to finish with them.
+    unsigned int retiredTables() const;
+
+private:
+    struct Node
+    {
+        ElementType element;
+        unsigned int hash;
+        Node* next;
+    };
+
+    // A Table owns every node reachable from its array.
+    struct Table
+    {
+        explicit Table(unsigned int capacity);
+        ~Table() noexcept;
+
+        unsigned int capacity;
+        std::atomic<Node*>* buckets;
+    };
+
+    struct RetiredTable
+    {
+        unsigned long long epoch;
+        Table* table;
+    };
+
+    HashFunction hashFunction;
+    std::atomic<Table*> table;
+    std::atomic<unsigned int> count;
+
+    // Everything below is only touched while holding writerMutex.
+    mutable std::mutex writerMutex;
+    std::vector<RetiredTable> retired;
+
+    template <typename Key>
+    bool find(const Key& element, unsigned int hash) const;
+
+    // Adds a node to the given table, which isn't yet visible to readers
+    // or whose writer lock is held.
+    static void insert(Table* table, const ElementType& element, unsigned int hash);
+
+    // Builds a new table of the given capacity containing copies of every
+    // node in the given one.
+    static Table* copyTable(const Table* table, unsigned int capacity);
+
+    void grow();
+
+    // Deletes every retired table that no reader can still be using.
+    void reclaim();
+};
+
+
+
+namespace impl_
+{
+    template <typename ElementType>
+    unsigned int ConcurrentHashSet__undefinedHashFunction(const ElementType& element)
+    {
+        return 0;
+    }
+
+
+    template <typename ElementType, typename Hasher>
+    Hasher ConcurrentHashSet__movedFromHashFunction()
+    {
+        if constexpr (std::is_constructible_v<Hasher, unsigned int (*)(const ElementType&)>)
+        {
+            return Hasher{ConcurrentHashSet__undefinedHashFunction<ElementType>};
+        }
+        else
+        {
+            return Hasher{};
+        }
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>::Table::Table(unsigned int capacity)
+    : capacity{capacity}, buckets{new std::atomic<Node*>[capacity]}
+{
+    for (unsigned int i = 0; i < capacity; ++i)
+    {
+        buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>::Table::~Table() noexcept
+{
+    for (unsigned int i = 0; i < capacity; ++i)
+    {
+        Node* n = buckets[i].load(std::memory_order_relaxed);
+
+        while (n != nullptr)
+        {
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    delete[] buckets;
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>::ConcurrentHashSet(HashFunction hashFunction)
+    : hashFunction{hashFunction}, table{new Table{DEFAULT_CAPACITY}}, count{0}
+{
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>::~ConcurrentHashSet() noexcept
+{
+    delete table.load();
+
+    for (const RetiredTable& r : retired)
+    {
+        delete r.table;
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>::ConcurrentHashSet(const ConcurrentHashSet& s)
+    : hashFunction{s.hashFunction}, table{nullptr}, count{s.count.load()}
+{
+    const Table* source = s.table.load();
+
+    table.store(
+        source == nullptr
+            ? new Table{DEFAULT_CAPACITY}
+            : copyTable(source, source->capacity));
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>::ConcurrentHashSet(ConcurrentHashSet&& s) noexcept
+    : hashFunction{impl_::ConcurrentHashSet__movedFromHashFunction<ElementType, Hasher>()},
+      table{nullptr}, count{0}
+{
+    std::swap(hashFunction, s.hashFunction);
+    table.store(s.table.exchange(nullptr));
+    count.store(s.count.exchange(0));
+    retired.swap(s.retired);
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>& ConcurrentHashSet<ElementType, Hasher>::operator=(const ConcurrentHashSet& s)
+{
+    if (this != &s)
+    {
+        ConcurrentHashSet copy{s};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType, typename Hasher>
+ConcurrentHashSet<ElementType, Hasher>& ConcurrentHashSet<ElementType, Hasher>::operator=(ConcurrentHashSet&& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    table.store(s.table.exchange(table.load()));
+    count.store(s.count.exchange(count.load()));
+    retired.swap(s.retired);
+    return *this;
+}
+
+
+template <typename ElementType, typename Hasher>
+bool ConcurrentHashSet<ElementType, Hasher>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename Hasher>
+void ConcurrentHashSet<ElementType, Hasher>::add(const ElementType& element)
+{
+    unsigned int hash = hashFunction(element);
+
+    std::lock_guard<std::mutex> lock{writerMutex};
+
+    if (table.load() == nullptr)
+    {
+        table.store(new Table{DEFAULT_CAPACITY});
+    }
+
+    if (find(element, hash))
+    {
+        return;
+    }
+
+    if (static_cast<double>(count.load(std::memory_order_relaxed) + 1) / table.load()->capacity > 0.8)
+    {
+        grow();
+    }
+
+    insert(table.load(), element, hash);
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    reclaim();
+}
+
+
+template <typename ElementType, typename Hasher>
+bool ConcurrentHashSet<ElementType, Hasher>::contains(const ElementType& element) const
+{
+    return find(element, hashFunction(element));
+}
+
+
+template <typename ElementType, typename Hasher>
+bool ConcurrentHashSet<ElementType, Hasher>::contains(std::string_view element) const
+{
+    if constexpr (std::is_invocable_r_v<unsigned int, const Hasher&, std::string_view>
+                  && std::is_convertible_v<const ElementType&, std::string_view>)
+    {
+        return find(element, hashFunction(element));
+    }
+    else if constexpr (std::is_same_v<ElementType, std::string>)
+    {
+        thread_local std::string scratch;
+        scratch.assign(element.data(), element.size());
+        return contains(scratch);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int ConcurrentHashSet<ElementType, Hasher>::size() const noexcept
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int ConcurrentHashSet<ElementType, Hasher>::capacity() const noexcept
+{
+    const Table* t = table.load();
+    return t == nullptr ? 0 : t->capacity;
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int ConcurrentHashSet<ElementType, Hasher>::retiredTables() const
+{
+    std::lock_guard<std::mutex> lock{writerMutex};
+    return retired.size();
+}
+
+
+template <typename ElementType, typename Hasher>
+template <typename Key>
+bool ConcurrentHashSet<ElementType, Hasher>::find(const Key& element, unsigned int hash) const
+{
+    EpochReclamation::ReadGuard guard;
+
+    const Table* t = table.load(std::memory_order_seq_cst);
+
+    if (t == nullptr)
+    {
+        return false;
+    }
+
+    for (const Node* n = t->buckets[hash % t->capacity].load(std::memory_order_acquire);
+         n != nullptr; n = n->next)
+    {
+        if (n->hash == hash && n->element == element)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename ElementType, typename Hasher>
+void ConcurrentHashSet<ElementType, Hasher>::insert(Table* table, const ElementType& element, unsigned int hash)
+{
+    std::atomic<Node*>& bucket = table->buckets[hash % table->capacity];
+    Node* node = new Node{element, hash, bucket.load(std::memory_order_relaxed)};
+    bucket.store(node, std::memory_order_release);
+}
+
+
+template <typename ElementType, typename Hasher>
+typename ConcurrentHashSet<ElementType, Hasher>::Table* ConcurrentHashSet<ElementType, Hasher>::copyTable(
+    const Table* table, unsigned int capacity)
+{
+    Table* copy = new Table{capacity};
+
+    try
+    {
+        for (unsigned int i = 0; i < table->capacity; ++i)
+        {
+            for (const Node* n = table->buckets[i].load(std::memory_order_acquire);
+                 n != nullptr; n = n->next)
+            {
+                insert(copy, n->element, n->hash);
+            }
+        }
+    }
+    catch (...)
+    {
+        delete copy;
+        throw;
+    }
+
+    return copy;
+}
+
+
+template <typename ElementType, typename Hasher>
+void ConcurrentHashSet<ElementType, Hasher>::grow()
+{
+    Table* old = table.load();
+    Table* grown = copyTable(old, old->capacity * 2 + 1);
+
+    retired.reserve(retired.size() + 1);
+    table.store(grown, std::memory_order_seq_cst);
+    retired.push_back(RetiredTable{EpochReclamation::retire(), old});
+}
+
+
+template <typename ElementType, typename Hasher>
+void ConcurrentHashSet<ElementType, Hasher>::reclaim()
+{
+    std::size_t kept = 0;
+
+    for (const RetiredTable& r : retired)
+    {
+        if (EpochReclamation::canReclaim(r.epoch))
+        {
+            delete r.table;
+        }
+        else
+        {
+            retired[kept++] = r;
+        }
+    }
+
+    retired.resize(kept);
+}
+
+
+#endif
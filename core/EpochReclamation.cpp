@@ -0,0 +1,125 @@
+// EpochReclamation.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <atomic>
+#include "EpochReclamation.hpp"
+
+
+
+namespace
+{
+    // A slot holds IDLE when its thread isn't reading, or the epoch it
+    // announced when its current read began.
+    constexpr unsigned long long IDLE = 0;
+
+
+    // Each slot is on its own cache line, so that readers announcing
+    // epochs don't contend with one another.
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<unsigned long long> epoch{IDLE};
+        std::atomic<bool> claimed{false};
+    };
+
+
+    std::atomic<unsigned long long> globalEpoch{1};
+    ReaderSlot slots[EpochReclamation::MAX_READERS];
+
+
+    // A thread's Registration claims a slot the first time the thread
+    // reads and gives it back when the thread exits.
+    class Registration
+    {
+    public:
+        Registration()
+            : slot{nullptr}, depth{0}
+        {
+            for (ReaderSlot& s : slots)
+            {
+                bool unclaimed = false;
+
+                if (s.claimed.compare_exchange_strong(unclaimed, true))
+                {
+                    slot = &s;
+                    return;
+                }
+            }
+
+            throw EpochReclamation::TooManyReadersException{};
+        }
+
+
+        ~Registration() noexcept
+        {
+            slot->epoch.store(IDLE);
+            slot->claimed.store(false);
+        }
+
+
+        ReaderSlot* slot;
+        unsigned int depth;
+    };
+
+
+    Registration& registration()
+    {
+        thread_local Registration r;
+        return r;
+    }
+}
+
+
+
+EpochReclamation::ReadGuard::ReadGuard()
+{
+    Registration& r = registration();
+    outermost = r.depth++ == 0;
+
+    if (outermost)
+    {
+        r.slot->epoch.store(globalEpoch.load());
+    }
+}
+
+
+EpochReclamation::ReadGuard::~ReadGuard() noexcept
+{
+    Registration& r = registration();
+    --r.depth;
+
+    if (outermost)
+    {
+        r.slot->epoch.store(IDLE);
+    }
+}
+
+
+unsigned long long EpochReclamation::currentEpoch() noexcept
+{
+    return globalEpoch.load();
+}
+
+
+unsigned long long EpochReclamation::retire() noexcept
+{
+    return globalEpoch.fetch_add(1);
+}
+
+
+bool EpochReclamation::canReclaim(unsigned long long retiredEpoch) noexcept
+{
+    for (const ReaderSlot& s : slots)
+    {
+        unsigned long long epoch = s.epoch.load();
+
+        if (epoch != IDLE && epoch <= retiredEpoch)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
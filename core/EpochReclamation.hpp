@@ -0,0 +1,71 @@
+// EpochReclamation.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Epoch-based reclamation lets a data structure that is read without locks
+// know when memory it has unlinked can safely be deleted, i.e., when no
+// reader could still be looking at it.
+//
+// There is one global epoch counter and a fixed number of reader slots.
+// A reader thread claims a slot the first time it reads, and thereafter
+// announces the current epoch in its slot for the duration of every read
+// (by holding an EpochReclamation::ReadGuard), clearing it afterward.
+// Entering and leaving a read are each a single load and store, so readers
+// never wait.
+//
+// A writer that unlinks something notes the current epoch as its
+// "retirement epoch" and then advances the epoch.  Any reader that starts
+// after that can't reach the unlinked memory, so it can be deleted once
+// every reader that is still in the middle of a read has announced an
+// epoch later than the retirement epoch.
+
+#ifndef EPOCHRECLAMATION_HPP
+#define EPOCHRECLAMATION_HPP
+
+
+
+class EpochReclamation
+{
+public:
+    // The largest number of threads that can be registered as readers at
+    // once.  A thread's slot is released when the thread exits.
+    static constexpr unsigned int MAX_READERS = 256;
+
+    // A TooManyReadersException is thrown when a thread tries to read
+    // while MAX_READERS other threads already hold slots.
+    class TooManyReadersException { };
+
+
+    // While a ReadGuard exists, memory retired after it was created won't
+    // be considered safe to reclaim.  ReadGuards can be nested.
+    class ReadGuard
+    {
+    public:
+        ReadGuard();
+        ~ReadGuard() noexcept;
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        bool outermost;
+    };
+
+
+    // currentEpoch() returns the value of the global epoch.
+    static unsigned long long currentEpoch() noexcept;
+
+    // retire() returns the epoch that memory unlinked just now should be
+    // tagged with, advancing the global epoch past it.
+    static unsigned long long retire() noexcept;
+
+    // canReclaim() returns true if no reader that might have seen memory
+    // retired in the given epoch is still reading.
+    static bool canReclaim(unsigned long long retiredEpoch) noexcept;
+};
+
+
+
+#endif
+
@@ -0,0 +1,609 @@
+// FlatHashSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FlatHashSet is an implementation of a Set that is an open-addressing
+// hash table.  Rather than chaining nodes off of each array cell, the
+// elements live directly in one flat array of slots, alongside a parallel
+// array of one-byte "control" values.  A control byte is either EMPTY or
+// a 7-bit tag taken from the element's hash, so most non-matching slots
+// can be rejected without ever touching the element itself.  A third
+// parallel array keeps each element's hash, so growing the table never
+// calls the hash function again.
+//
+// The slots are organized into groups of GROUP_SIZE (16) consecutive
+// slots.  A lookup hashes the element once, picks a starting group, and
+// then compares all 16 control bytes of that group against the tag at
+// once (using SSE2 when it's available, or a plain loop otherwise).  If
+// the group contains an EMPTY slot and no match, the element is absent;
+// otherwise, the search moves on to the next group in the probe sequence.
+//
+// The number of groups is always a power of two, and the table grows to
+// twice as many groups whenever more than 7/8 of its slots would be full.
+//
+// Where HashSet reports on its chains, FlatHashSet reports on its slot
+// groups: elementsAtIndex() and isElementAtIndex() take a group index.
+
+#ifndef FLATHASHSET_HPP
+#define FLATHASHSET_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "Set.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+
+template <typename ElementType>
+class FlatHashSet : public Set<ElementType>
+{
+public:
+    // The number of slots whose control bytes are examined together.
+    static constexpr unsigned int GROUP_SIZE = 16;
+
+    // The number of slot groups in a FlatHashSet before anything has
+    // been added to it.
+    static constexpr unsigned int DEFAULT_GROUP_COUNT = 1;
+
+    // A HashFunction is a function that takes a reference to a const
+    // ElementType and returns an unsigned int.
+    using HashFunction = std::function<unsigned int(const ElementType&)>;
+
+public:
+    // Initializes a FlatHashSet to be empty, so that it will use the given
+    // hash function whenever it needs to hash an element.
+    explicit FlatHashSet(HashFunction hashFunction);
+
+    // Cleans up the FlatHashSet so that it leaks no memory.
+    ~FlatHashSet() noexcept override;
+
+    // Initializes a new FlatHashSet to be a copy of an existing one.
+    FlatHashSet(const FlatHashSet& s);
+
+    // Initializes a new FlatHashSet whose contents are moved from an
+    // expiring one.
+    FlatHashSet(FlatHashSet&& s) noexcept;
+
+    // Assigns an existing FlatHashSet into another.
+    FlatHashSet& operator=(const FlatHashSet& s);
+
+    // Assigns an expiring FlatHashSet into another.
+    FlatHashSet& operator=(FlatHashSet&& s) noexcept;
+
+
+    bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  When more than 7/8 of the slots
+    // would be full, the number of groups is doubled and every element is
+    // reinserted, which takes linear time; otherwise, this function runs in
+    // expected constant time.
+    void add(const ElementType& element) override;
+
+
+    using Set<ElementType>::contains;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function runs in expected constant time.
+    bool contains(const ElementType& element) const override;
+
+
+    // contains() can also be asked about a std::string_view.  Because the
+    // hash function expects an ElementType, the view is copied into a
+    // per-thread scratch string whose capacity is reused from one call to
+    // the next, so lookups stop allocating once the scratch has grown to
+    // the longest word seen.
+    bool contains(std::string_view element) const override;
+
+
+    // size() returns the number of elements in the set.
+    unsigned int size() const noexcept override;
+
+
+    // reserve() doubles the number of groups, all at once, until the given
+    // number of elements would fill no more than 7/8 of the slots.
+    void reserve(unsigned int elementCount) override;
+
+
+    // groupCount() returns the number of slot groups in the table.
+    unsigned int groupCount() const noexcept;
+
+
+    // elementsAtIndex() returns the number of elements stored in the
+    // given slot group.  If the index is out of the boundaries of the
+    // table, this function returns 0.
+    unsigned int elementsAtIndex(unsigned int index) const;
+
+
+    // isElementAtIndex() returns true if the given element is stored in
+    // the given slot group, false otherwise.  If the index is out of the
+    // boundaries of the table, this function returns false.
+    bool isElementAtIndex(const ElementType& element, unsigned int index) const;
+
+
+private:
+    // A control byte is EMPTY or, for a full slot, the 7-bit tag (0-127)
+    // of the element stored there.
+    static constexpr std::int8_t EMPTY = -128;
+
+    // A Probe is the result of hashing an element: the hash itself, the
+    // bits that choose which group to start searching from, and the tag
+    // to look for.
+    struct Probe
+    {
+        unsigned int hash;
+        std::uint32_t groupHash;
+        std::int8_t tag;
+    };
+
+    HashFunction hashFunction;
+    std::int8_t* controls;
+    unsigned int* hashes;
+    ElementType* slots;
+    unsigned int groups;
+    unsigned int count;
+
+    Probe probeFor(const ElementType& element) const;
+    static Probe probeForHash(unsigned int hash) noexcept;
+
+    // Returns the group at which the probe sequence for the given probe
+    // starts.
+    unsigned int startGroup(const Probe& probe) const noexcept;
+
+    // Returns a bitmask with bit i set when control byte i of the given
+    // group equals the given value.
+    static std::uint32_t matchByte(const std::int8_t* group, std::int8_t value) noexcept;
+
+    // Returns the slot index at which the element is stored, or -1 if
+    // it isn't in the table.
+    long long find(const ElementType& element, const Probe& probe) const;
+
+    // Stores an element known not to be in the table into the first
+    // EMPTY slot along its probe sequence.
+    void insertUnique(const ElementType& element, const Probe& probe);
+    void insertUnique(ElementType&& element, const Probe& probe);
+
+    // Returns the first EMPTY slot along the given probe sequence.
+    unsigned int emptySlotFor(const Probe& probe) const noexcept;
+
+    // Marks the given slot as holding an element with the given probe.
+    void fillSlot(unsigned int slot, const Probe& probe) noexcept;
+
+    // Replaces the arrays with empty ones for the given number of groups.
+    // If allocating any of them throws, the set is left as it was.
+    void allocate(unsigned int groupCount);
+    void release() noexcept;
+    void copyFrom(const FlatHashSet& s);
+    void grow();
+    void rehash(unsigned int groupCount);
+};
+
+
+
+namespace impl_
+{
+    template <typename ElementType>
+    unsigned int FlatHashSet__undefinedHashFunction(const ElementType& element)
+    {
+        return 0;
+    }
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(HashFunction hashFunction)
+    : hashFunction{hashFunction}, controls{nullptr}, hashes{nullptr}, slots{nullptr},
+      groups{0}, count{0}
+{
+    allocate(DEFAULT_GROUP_COUNT);
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::~FlatHashSet() noexcept
+{
+    release();
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(const FlatHashSet& s)
+    : hashFunction{s.hashFunction}, controls{nullptr}, hashes{nullptr}, slots{nullptr},
+      groups{0}, count{0}
+{
+    copyFrom(s);
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(FlatHashSet&& s) noexcept
+    : hashFunction{impl_::FlatHashSet__undefinedHashFunction<ElementType>},
+      controls{nullptr}, hashes{nullptr}, slots{nullptr}, groups{0}, count{0}
+{
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(controls, s.controls);
+    std::swap(hashes, s.hashes);
+    std::swap(slots, s.slots);
+    std::swap(groups, s.groups);
+    std::swap(count, s.count);
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>& FlatHashSet<ElementType>::operator=(const FlatHashSet& s)
+{
+    if (this != &s)
+    {
+        FlatHashSet copy{s};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>& FlatHashSet<ElementType>::operator=(FlatHashSet&& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(controls, s.controls);
+    std::swap(hashes, s.hashes);
+    std::swap(slots, s.slots);
+    std::swap(groups, s.groups);
+    std::swap(count, s.count);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool FlatHashSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::add(const ElementType& element)
+{
+    Probe probe = probeFor(element);
+
+    if (find(element, probe) >= 0)
+    {
+        return;
+    }
+
+    if (groups == 0 || (count + 1) * 8 > groups * GROUP_SIZE * 7)
+    {
+        grow();
+    }
+
+    insertUnique(element, probe);
+    ++count;
+}
+
+
+template <typename ElementType>
+bool FlatHashSet<ElementType>::contains(const ElementType& element) const
+{
+    return groups != 0 && find(element, probeFor(element)) >= 0;
+}
+
+
+template <typename ElementType>
+bool FlatHashSet<ElementType>::contains(std::string_view element) const
+{
+    if constexpr (std::is_same_v<ElementType, std::string>)
+    {
+        thread_local std::string scratch;
+        scratch.assign(element.data(), element.size());
+        return contains(scratch);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::reserve(unsigned int elementCount)
+{
+    unsigned int newGroups = groups == 0 ? DEFAULT_GROUP_COUNT : groups;
+
+    while (static_cast<unsigned long long>(elementCount) * 8 > static_cast<unsigned long long>(newGroups) * GROUP_SIZE * 7)
+    {
+        newGroups *= 2;
+    }
+
+    if (newGroups != groups)
+    {
+        rehash(newGroups);
+    }
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::groupCount() const noexcept
+{
+    return groups;
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::elementsAtIndex(unsigned int index) const
+{
+    if (index >= groups)
+    {
+        return 0;
+    }
+
+    return GROUP_SIZE - __builtin_popcount(matchByte(controls + index * GROUP_SIZE, EMPTY));
+}
+
+
+template <typename ElementType>
+bool FlatHashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned int index) const
+{
+    if (index >= groups)
+    {
+        return false;
+    }
+
+    long long slot = find(element, probeFor(element));
+    return slot >= 0 && static_cast<unsigned long long>(slot) / GROUP_SIZE == index;
+}
+
+
+template <typename ElementType>
+typename FlatHashSet<ElementType>::Probe FlatHashSet<ElementType>::probeFor(const ElementType& element) const
+{
+    return probeForHash(hashFunction(element));
+}
+
+
+template <typename ElementType>
+typename FlatHashSet<ElementType>::Probe FlatHashSet<ElementType>::probeForHash(unsigned int hash) noexcept
+{
+    // The user's hash function may distribute its bits poorly (e.g., by
+    // summing character codes, or leaving its low bits constant), so it's
+    // multiplied by 2^64 divided by the golden ratio.  Every bit of the
+    // product's upper half depends on every bit of the hash; the group is
+    // chosen by its topmost bits and the tag is taken from its lowest.
+    std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+
+    return Probe{
+        hash,
+        static_cast<std::uint32_t>(mixed >> 32),
+        static_cast<std::int8_t>((mixed >> 32) & 0x7F)};
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::startGroup(const Probe& probe) const noexcept
+{
+    // Since the number of groups is a power of two, this is the top
+    // log2(groups) bits of the group hash.
+    return static_cast<unsigned int>((static_cast<std::uint64_t>(probe.groupHash) * groups) >> 32);
+}
+
+
+template <typename ElementType>
+std::uint32_t FlatHashSet<ElementType>::matchByte(const std::int8_t* group, std::int8_t value) noexcept
+{
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+    std::uint32_t mask = 0;
+
+    for (unsigned int i = 0; i < GROUP_SIZE; ++i)
+    {
+        mask |= static_cast<std::uint32_t>(group[i] == value) << i;
+    }
+
+    return mask;
+#endif
+}
+
+
+template <typename ElementType>
+long long FlatHashSet<ElementType>::find(const ElementType& element, const Probe& probe) const
+{
+    if (groups == 0)
+    {
+        return -1;
+    }
+
+    // Triangular probing over a power-of-two number of groups visits
+    // every group exactly once before repeating.
+    unsigned int mask = groups - 1;
+    unsigned int group = startGroup(probe);
+
+    for (unsigned int step = 1; step <= groups; ++step)
+    {
+        const std::int8_t* groupControls = controls + group * GROUP_SIZE;
+
+        for (std::uint32_t matches = matchByte(groupControls, probe.tag); matches != 0; matches &= matches - 1)
+        {
+            unsigned int slot = group * GROUP_SIZE + __builtin_ctz(matches);
+
+            if (slots[slot] == element)
+            {
+                return slot;
+            }
+        }
+
+        if (matchByte(groupControls, EMPTY) != 0)
+        {
+            return -1;
+        }
+
+        group = (group + step) & mask;
+    }
+
+    return -1;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::insertUnique(const ElementType& element, const Probe& probe)
+{
+    unsigned int slot = emptySlotFor(probe);
+    slots[slot] = element;
+    fillSlot(slot, probe);
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::insertUnique(ElementType&& element, const Probe& probe)
+{
+    unsigned int slot = emptySlotFor(probe);
+    slots[slot] = std::move(element);
+    fillSlot(slot, probe);
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::emptySlotFor(const Probe& probe) const noexcept
+{
+    unsigned int mask = groups - 1;
+    unsigned int group = startGroup(probe);
+
+    for (unsigned int step = 1; ; ++step)
+    {
+        std::uint32_t empties = matchByte(controls + group * GROUP_SIZE, EMPTY);
+
+        if (empties != 0)
+        {
+            return group * GROUP_SIZE + __builtin_ctz(empties);
+        }
+
+        group = (group + step) & mask;
+    }
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::fillSlot(unsigned int slot, const Probe& probe) noexcept
+{
+    controls[slot] = probe.tag;
+    hashes[slot] = probe.hash;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::allocate(unsigned int groupCount)
+{
+    unsigned int slotCount = groupCount * GROUP_SIZE;
+
+    std::unique_ptr<std::int8_t[]> newControls{new std::int8_t[slotCount]};
+    std::unique_ptr<unsigned int[]> newHashes{new unsigned int[slotCount]};
+    std::unique_ptr<ElementType[]> newSlots{new ElementType[slotCount]};
+
+    std::fill_n(newControls.get(), slotCount, EMPTY);
+
+    controls = newControls.release();
+    hashes = newHashes.release();
+    slots = newSlots.release();
+    groups = groupCount;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::release() noexcept
+{
+    delete[] controls;
+    delete[] hashes;
+    delete[] slots;
+    controls = nullptr;
+    hashes = nullptr;
+    slots = nullptr;
+    groups = 0;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::copyFrom(const FlatHashSet& s)
+{
+    allocate(s.groups);
+
+    unsigned int slotCount = groups * GROUP_SIZE;
+
+    try
+    {
+        for (unsigned int i = 0; i < slotCount; ++i)
+        {
+            controls[i] = s.controls[i];
+
+            if (controls[i] != EMPTY)
+            {
+                hashes[i] = s.hashes[i];
+                slots[i] = s.slots[i];
+            }
+        }
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+
+    count = s.count;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::grow()
+{
+    rehash(groups == 0 ? DEFAULT_GROUP_COUNT : groups * 2);
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::rehash(unsigned int groupCount)
+{
+    std::int8_t* oldControls = controls;
+    unsigned int* oldHashes = hashes;
+    ElementType* oldSlots = slots;
+    unsigned int oldSlotCount = groups * GROUP_SIZE;
+
+    // If allocate() throws, the set still owns the old arrays; otherwise,
+    // they're released once their elements have been moved out of them.
+    allocate(groupCount);
+
+    std::unique_ptr<std::int8_t[]> releaseControls{oldControls};
+    std::unique_ptr<unsigned int[]> releaseHashes{oldHashes};
+    std::unique_ptr<ElementType[]> releaseSlots{oldSlots};
+
+    for (unsigned int i = 0; i < oldSlotCount; ++i)
+    {
+        if (oldControls[i] != EMPTY)
+        {
+            insertUnique(std::move(oldSlots[i]), probeForHash(oldHashes[i]));
+        }
+    }
+}
+
+
+
+#endif
@@ -0,0 +1,38 @@
+// FrozenAVLSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FrozenAVLSet is an AVLSet that freezes itself (see AVLSet::freeze())
+// whenever it's told that no more elements will be added for a while, as
+// addAll() does once it's added its whole range.  It can be used wherever
+// an AVLSet can; adding another element afterward goes back to searching
+// the tree until the set is frozen again.
+
+#ifndef FROZENAVLSET_HPP
+#define FROZENAVLSET_HPP
+
+#include "AVLSet.hpp"
+
+
+
+template <typename ElementType>
+class FrozenAVLSet : public AVLSet<ElementType>
+{
+public:
+    using AVLSet<ElementType>::AVLSet;
+
+    void finishAdding() override;
+};
+
+
+
+template <typename ElementType>
+void FrozenAVLSet<ElementType>::finishAdding()
+{
+    this->freeze();
+}
+
+
+
+#endif
@@ -14,6 +14,20 @@
 // elements as there are array cells), the HashSet should be resized so
 // that it is twice as large as it was before.
 //
+// Ordinarily, that resizing happens all at once, so the one add() that
+// crosses the threshold pays for relinking every element.  A HashSet can
+// instead be constructed to resize incrementally: the old and new arrays
+// are kept side by side, a few chains at a time are moved from the old
+// one into the new one on each subsequent add() or contains(), and
+// lookups consult both arrays until the move is finished.
+//
+// Rather than allocating each node separately, nodes are allocated from
+// a SlabArena and linked to one another by index, and the characters of
+// std::string elements are copied back to back into one CharArena.  This
+// keeps a chain's nodes and keys close together in memory, lets the whole
+// structure be destroyed a slab at a time, and makes copying a HashSet a
+// matter of copying a handful of large arrays.
+//
 // You are not permitted to use the containers in the C++ Standard Library
 // (such as std::set, std::map, or std::vector) to store the information
 // in your data structure.  Instead, you'll need to use a dynamically-
@@ -23,12 +37,33 @@
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
 #include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "CharArena.hpp"
+#include "HashSetStats.hpp"
 #include "Set.hpp"
+#include "SlabArena.hpp"
+
+
+
+// HashSetResizing indicates how a HashSet moves its elements into a
+// larger array when it grows: all at once, or a few chains at a time.
+
+enum class HashSetResizing
+{
+    AllAtOnce,
+    Incremental
+};
 
 
 
-template <typename ElementType>
+template <typename ElementType, typename Hasher = std::function<unsigned int(const ElementType&)>>
 class HashSet : public Set<ElementType>
 {
 public:
@@ -36,14 +71,33 @@ public:
     // added to it.
     static constexpr unsigned int DEFAULT_CAPACITY = 10;
 
+    // The number of chains moved from the old array into the new one on
+    // each add() or contains() while an incremental resize is underway.
+    static constexpr unsigned int MIGRATION_STEP = 4;
+
     // A HashFunction is a function that takes a reference to a const
-    // ElementType and returns an unsigned int.
-    using HashFunction = std::function<unsigned int(const ElementType&)>;
+    // ElementType and returns an unsigned int.  By default, it's a
+    // std::function, so any such function can be used, but every call is
+    // then an indirect one.  A HashSet can instead be given the type of a
+    // function object (such as ProductHash in StringHashing.hpp) as its
+    // second template argument, in which case the compiler can inline the
+    // hashing into add() and contains().
+    using HashFunction = Hasher;
 
 public:
     // Initializes a HashSet to be empty, so that it will use the given
-    // hash function whenever it needs to hash an element.
-    explicit HashSet(HashFunction hashFunction);
+    // hash function whenever it needs to hash an element, and resize in
+    // the given way.
+    explicit HashSet(
+        HashFunction hashFunction,
+        HashSetResizing resizing = HashSetResizing::AllAtOnce);
+
+    // Initializes a HashSet containing the elements in the range
+    // [begin, end), sized once up front when the range's length is known.
+    template <typename Iterator>
+    HashSet(
+        HashFunction hashFunction, Iterator begin, Iterator end,
+        HashSetResizing resizing = HashSetResizing::AllAtOnce);
 
     // Cleans up the HashSet so that it leaks no memory.
     ~HashSet() noexcept override;
@@ -74,42 +128,195 @@ public:
     //
     //     capacity * 2 + 1
     //
-    // In the case where the array is resized, this function runs in linear
-    // time (with respect to the number of elements, assuming a good hash
-    // function); otherwise, it runs in constant time (again, assuming a good
-    // hash function).  The amortized running time is also constant.
+    // When resizing all at once (the default), the call that resizes the
+    // array relinks every element into it, so it runs in linear time (with
+    // respect to the number of elements, assuming a good hash function);
+    // every other call runs in constant time (again, assuming a good hash
+    // function).  When resizing incrementally, the call that resizes only
+    // allocates and clears the new array, and it and each later call moves
+    // at most MIGRATION_STEP chains from the old array into it, so no call
+    // relinks more than a few chains' worth of elements.  Either way, the
+    // amortized running time is constant.
     void add(const ElementType& element) override;
 
 
+    using Set<ElementType>::contains;
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in constant time (with respect
-    // to the number of elements, assuming a good hash function).
+    // to the number of elements, assuming a good hash function).  During
+    // an incremental resize, it also moves a few chains into the new array,
+    // so it is not safe to call concurrently in that mode.
     bool contains(const ElementType& element) const override;
 
 
+    // contains() can also be asked about a std::string_view.  If the hash
+    // function can be called with a std::string_view, the view is hashed
+    // and compared directly.  Otherwise, it is copied into a per-thread
+    // scratch string whose capacity is reused from one call to the next,
+    // so lookups stop allocating once the scratch has grown to the longest
+    // word seen.
+    bool contains(std::string_view element) const override;
+
+
+    // containsWithHash() is contains() for a caller that has already
+    // calculated the given element's hash, exactly as this HashSet's hash
+    // function would have (e.g., incrementally, with RollingProductHash in
+    // StringHashing.hpp), so that all that's left is to search one chain.
+    // The element can be an ElementType or, for a HashSet of std::string,
+    // a std::string_view.
+    template <typename Key>
+    bool containsWithHash(const Key& element, unsigned int hash) const;
+
+
+    // containsMany() is containsWithHash() for a batch of elements (such
+    // as strings hashed together with hashMany() in StringHashing.hpp),
+    // storing whether each is in the set in the array "results."  The
+    // batch is searched a group at a time: the first node of every
+    // element's chain in the group is looked up and prefetched before any
+    // of the chains are searched, so that their cache misses overlap.
+    template <typename Key>
+    void containsMany(
+        const Key* elements, const unsigned int* hashes, std::size_t count, bool* results) const;
+
+
+    // hasher() returns the hash function this HashSet was given.
+    const HashFunction& hasher() const noexcept;
+
+
+    // forEach() calls the given function once for each element, in the
+    // order in which they were added.  A HashSet of std::string passes
+    // each element as a std::string_view of its stored characters, which
+    // never move, so the view stays valid until the HashSet is destroyed
+    // or assigned to; any other HashSet passes a reference to a const
+    // ElementType.
+    template <typename Visit>
+    void forEach(Visit visit) const;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
 
+    // reserve() grows the array, all at once, to the first capacity in the
+    // sequence 10, 21, 43, ... that can hold the given number of elements
+    // without exceeding the 0.8 ratio, so that adding that many elements
+    // triggers no further resizing.  If the array is already large enough,
+    // this function has no effect.
+    void reserve(unsigned int elementCount) override;
+
+
     // elementsAtIndex() returns the number of elements that hashed to a
     // particular index in the array.  If the index is out of the boundaries
-    // of the array, this function returns 0.
+    // of the array, this function returns 0.  Any incremental resize that
+    // is underway is finished first.
     unsigned int elementsAtIndex(unsigned int index) const;
 
 
     // isElementAtIndex() returns true if the given element hashed to a
     // particular index in the array, false otherwise.  If the index is
     // out of the boundaries of the array, this functions returns false.
+    // Any incremental resize that is underway is finished first.
     bool isElementAtIndex(const ElementType& element, unsigned int index) const;
 
 
+    // stats() returns a snapshot of the array's capacity, size, and load
+    // factor, the distribution of its chains' lengths, and how many nodes
+    // lookups examine on average (see HashSetStats.hpp).  This function
+    // runs in linear time.  Any incremental resize that is underway is
+    // finished first.
+    HashSetStats stats() const;
+
+
 private:
     HashFunction hashFunction;
 
-    // You'll no doubt want to add member variables and "helper" member
-    // functions here.
-};
+    // A std::string element is stored as the offset and length of its
+    // characters in the CharArena; any other element is stored as-is.
+    struct StoredString
+    {
+        unsigned int offset;
+        unsigned int length;
+    };
 
+    static constexpr bool STORES_CHARS = std::is_same_v<ElementType, std::string>;
+
+    using StoredElement = std::conditional_t<STORES_CHARS, StoredString, ElementType>;
+
+    // Each cell of the array is the index of the first node of a singly-
+    // linked list of the elements that hashed to that index.  Every node
+    // remembers the full hash of its element, so that resizing never has
+    // to call the hash function again and lookups can skip any node whose
+    // hash differs without comparing elements.
+    struct Node
+    {
+        StoredElement element;
+        unsigned int hash;
+        unsigned int next;
+    };
+
+    // The index that marks the end of a chain.
+    static constexpr unsigned int NO_NODE = UINT_MAX;
+
+    // The number of chains containsMany() looks up before searching them.
+    static constexpr std::size_t BATCH_GROUP = 16;
+
+    // The nodes are mutable because contains() relinks them during an
+    // incremental resize.
+    mutable SlabArena<Node> nodes;
+    CharArena chars;
+
+    unsigned int* buckets;
+    unsigned int capacity;
+    unsigned int count;
+    HashSetResizing resizing;
+
+    // While an incremental resize is underway, oldBuckets is the array
+    // being emptied and every chain before index "migrated" has already
+    // been moved; otherwise, oldBuckets is nullptr.  These are mutable
+    // because contains() does its share of the moving.
+    mutable unsigned int* oldBuckets;
+    mutable unsigned int oldCapacity;
+    mutable unsigned int migrated;
+
+    // Allocates an array of the given capacity with every chain empty.
+    static unsigned int* makeBuckets(unsigned int capacity);
+
+    // Copies the given array (or returns nullptr when given nullptr).
+    static unsigned int* copyBuckets(const unsigned int* buckets, unsigned int capacity);
+
+    // Returns true if the given node's element is equal to the given one,
+    // which is either an ElementType or a std::string_view.
+    template <typename Key>
+    bool matches(const Node& node, const Key& element) const;
+
+    // Returns the index of the node in the appropriate chain whose element
+    // is equal to the given one, which has the given hash, or NO_NODE if
+    // there is none.
+    template <typename Key>
+    unsigned int find(const Key& element, unsigned int hash) const;
+
+    // Moves every node of the given chain into its chain in the given
+    // array, leaving the given chain empty.
+    void relinkChain(unsigned int& chain, unsigned int* buckets, unsigned int capacity) const noexcept;
+
+    // Grows the array to capacity * 2 + 1, either relinking every existing
+    // node into its new chain or starting an incremental resize.
+    void grow();
+
+    // Replaces the array with one of the given capacity, relinking every
+    // existing node into its new chain immediately.
+    void rehash(unsigned int newCapacity);
+
+    // Moves up to the given number of chains out of oldBuckets, releasing
+    // it once it's empty.
+    void migrate(unsigned int chains) const noexcept;
+
+    void finishMigration() const noexcept;
+
+    void swap(HashSet& s) noexcept;
+};
 
 
 namespace impl_
@@ -119,91 +326,558 @@ namespace impl_
     {
         return 0;
     }
+
+
+    // The hash function left behind in a HashSet that has been moved from.
+    template <typename ElementType, typename Hasher>
+    Hasher HashSet__movedFromHashFunction()
+    {
+        if constexpr (std::is_constructible_v<Hasher, unsigned int (*)(const ElementType&)>)
+        {
+            return Hasher{HashSet__undefinedHashFunction<ElementType>};
+        }
+        else
+        {
+            return Hasher{};
+        }
+    }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashFunction hashFunction)
-    : hashFunction{hashFunction}
+template <typename ElementType, typename Hasher>
+HashSet<ElementType, Hasher>::HashSet(HashFunction hashFunction, HashSetResizing resizing)
+    : hashFunction{hashFunction},
+      buckets{makeBuckets(DEFAULT_CAPACITY)},
+      capacity{DEFAULT_CAPACITY},
+      count{0},
+      resizing{resizing},
+      oldBuckets{nullptr},
+      oldCapacity{0},
+      migrated{0}
 {
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::~HashSet() noexcept
+template <typename ElementType, typename Hasher>
+template <typename Iterator>
+HashSet<ElementType, Hasher>::HashSet(
+    HashFunction hashFunction, Iterator begin, Iterator end, HashSetResizing resizing)
+    : HashSet{hashFunction, resizing}
 {
+    this->addAll(begin, end);
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(const HashSet& s)
-    : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}
+template <typename ElementType, typename Hasher>
+HashSet<ElementType, Hasher>::~HashSet() noexcept
 {
+    delete[] buckets;
+    delete[] oldBuckets;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashSet&& s) noexcept
-    : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>}
+template <typename ElementType, typename Hasher>
+HashSet<ElementType, Hasher>::HashSet(const HashSet& s)
+    : hashFunction{s.hashFunction},
+      nodes{s.nodes},
+      chars{s.chars},
+      buckets{copyBuckets(s.buckets, s.capacity)},
+      capacity{s.capacity},
+      count{s.count},
+      resizing{s.resizing},
+      oldBuckets{nullptr},
+      oldCapacity{s.oldCapacity},
+      migrated{s.migrated}
 {
+    try
+    {
+        oldBuckets = copyBuckets(s.oldBuckets, s.oldCapacity);
+    }
+    catch (...)
+    {
+        delete[] buckets;
+        throw;
+    }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
+template <typename ElementType, typename Hasher>
+HashSet<ElementType, Hasher>::HashSet(HashSet&& s) noexcept
+    : hashFunction{impl_::HashSet__movedFromHashFunction<ElementType, Hasher>()},
+      buckets{nullptr},
+      capacity{0},
+      count{0},
+      resizing{HashSetResizing::AllAtOnce},
+      oldBuckets{nullptr},
+      oldCapacity{0},
+      migrated{0}
 {
+    swap(s);
+}
+
+
+template <typename ElementType, typename Hasher>
+HashSet<ElementType, Hasher>& HashSet<ElementType, Hasher>::operator=(const HashSet& s)
+{
+    if (this != &s)
+    {
+        HashSet copy{s};
+        swap(copy);
+    }
+
     return *this;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
+template <typename ElementType, typename Hasher>
+HashSet<ElementType, Hasher>& HashSet<ElementType, Hasher>::operator=(HashSet&& s) noexcept
 {
+    swap(s);
     return *this;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename Hasher>
+bool HashSet<ElementType, Hasher>::isImplemented() const noexcept
 {
-    return false;
+    return true;
 }
 
 
-template <typename ElementType>
-void HashSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::add(const ElementType& element)
 {
+    migrate(MIGRATION_STEP);
+
+    unsigned int hash = hashFunction(element);
+
+    if (find(element, hash) != NO_NODE)
+    {
+        return;
+    }
+
+    if (capacity == 0 || static_cast<double>(count + 1) / capacity > 0.8)
+    {
+        grow();
+    }
+
+    StoredElement stored;
+
+    if constexpr (STORES_CHARS)
+    {
+        stored = StoredString{
+            chars.append(element), static_cast<unsigned int>(element.length())};
+    }
+    else
+    {
+        stored = element;
+    }
+
+    unsigned int index = hash % capacity;
+    buckets[index] = nodes.allocate(Node{stored, hash, buckets[index]});
+    ++count;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, typename Hasher>
+bool HashSet<ElementType, Hasher>::contains(const ElementType& element) const
 {
-    return false;
+    migrate(MIGRATION_STEP);
+    return find(element, hashFunction(element)) != NO_NODE;
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::size() const noexcept
+template <typename ElementType, typename Hasher>
+bool HashSet<ElementType, Hasher>::contains(std::string_view element) const
 {
-    return 0;
+    if constexpr (STORES_CHARS && std::is_invocable_r_v<unsigned int, const Hasher&, std::string_view>)
+    {
+        migrate(MIGRATION_STEP);
+        return find(element, hashFunction(element)) != NO_NODE;
+    }
+    else if constexpr (STORES_CHARS)
+    {
+        thread_local std::string scratch;
+        scratch.assign(element.data(), element.size());
+        return contains(scratch);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
+template <typename ElementType, typename Hasher>
+template <typename Key>
+bool HashSet<ElementType, Hasher>::containsWithHash(const Key& element, unsigned int hash) const
 {
-    return 0;
+    migrate(MIGRATION_STEP);
+    return find(element, hash) != NO_NODE;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned int index) const
+template <typename ElementType, typename Hasher>
+template <typename Key>
+void HashSet<ElementType, Hasher>::containsMany(
+    const Key* elements, const unsigned int* hashes, std::size_t count, bool* results) const
 {
-    return false;
+    migrate(MIGRATION_STEP);
+
+    // While an incremental resize is underway, an element might be in
+    // either array, so the batch is searched the ordinary way.
+    if (oldBuckets != nullptr || capacity == 0)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            results[i] = find(elements[i], hashes[i]) != NO_NODE;
+        }
+
+        return;
+    }
+
+    unsigned int heads[BATCH_GROUP];
+
+    for (std::size_t first = 0; first < count; first += BATCH_GROUP)
+    {
+        std::size_t last = std::min(count, first + BATCH_GROUP);
+
+        for (std::size_t i = first; i < last; ++i)
+        {
+            heads[i - first] = buckets[hashes[i] % capacity];
+
+            if (heads[i - first] != NO_NODE)
+            {
+                __builtin_prefetch(&nodes[heads[i - first]]);
+            }
+        }
+
+        for (std::size_t i = first; i < last; ++i)
+        {
+            results[i] = false;
+
+            for (unsigned int n = heads[i - first]; n != NO_NODE; n = nodes[n].next)
+            {
+                if (nodes[n].hash == hashes[i] && matches(nodes[n], elements[i]))
+                {
+                    results[i] = true;
+                    break;
+                }
+            }
+        }
+    }
 }
 
 
+template <typename ElementType, typename Hasher>
+const typename HashSet<ElementType, Hasher>::HashFunction& HashSet<ElementType, Hasher>::hasher() const noexcept
+{
+    return hashFunction;
+}
 
-#endif
 
+template <typename ElementType, typename Hasher>
+template <typename Visit>
+void HashSet<ElementType, Hasher>::forEach(Visit visit) const
+{
+    // Nodes are never removed, so the slab holds exactly the elements, in
+    // the order they were allocated.
+    for (unsigned int n = 0; n < nodes.size(); ++n)
+    {
+        if constexpr (STORES_CHARS)
+        {
+            visit(chars.view(nodes[n].element.offset, nodes[n].element.length));
+        }
+        else
+        {
+            visit(static_cast<const ElementType&>(nodes[n].element));
+        }
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int HashSet<ElementType, Hasher>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::reserve(unsigned int elementCount)
+{
+    unsigned int newCapacity = capacity == 0 ? DEFAULT_CAPACITY : capacity;
+
+    while (static_cast<double>(elementCount) / newCapacity > 0.8)
+    {
+        newCapacity = newCapacity * 2 + 1;
+    }
+
+    if (newCapacity != capacity)
+    {
+        rehash(newCapacity);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int HashSet<ElementType, Hasher>::elementsAtIndex(unsigned int index) const
+{
+    finishMigration();
+
+    if (index >= capacity)
+    {
+        return 0;
+    }
+
+    unsigned int elements = 0;
+
+    for (unsigned int n = buckets[index]; n != NO_NODE; n = nodes[n].next)
+    {
+        ++elements;
+    }
+
+    return elements;
+}
+
+
+template <typename ElementType, typename Hasher>
+bool HashSet<ElementType, Hasher>::isElementAtIndex(const ElementType& element, unsigned int index) const
+{
+    finishMigration();
+
+    if (index >= capacity)
+    {
+        return false;
+    }
+
+    unsigned int hash = hashFunction(element);
+    return hash % capacity == index && find(element, hash) != NO_NODE;
+}
+
+
+template <typename ElementType, typename Hasher>
+HashSetStats HashSet<ElementType, Hasher>::stats() const
+{
+    finishMigration();
+
+    HashSetStats stats{};
+    stats.capacity = capacity;
+    stats.size = count;
+    stats.loadFactor = capacity == 0 ? 0.0 : static_cast<double>(count) / capacity;
+
+    // Finding the k-th node of a chain examines k nodes, so finding every
+    // node of a chain of length L examines L(L + 1) / 2 in total, while
+    // failing to find something in it examines all L.
+    double successfulProbes = 0.0;
+    double unsuccessfulProbes = 0.0;
+
+    for (unsigned int i = 0; i < capacity; ++i)
+    {
+        unsigned int length = 0;
+
+        for (unsigned int n = buckets[i]; n != NO_NODE; n = nodes[n].next)
+        {
+            ++length;
+        }
+
+        if (length >= stats.chainLengths.size())
+        {
+            stats.chainLengths.resize(length + 1, 0);
+        }
+
+        ++stats.chainLengths[length];
+        stats.longestChain = std::max(stats.longestChain, length);
+
+        successfulProbes += static_cast<double>(length) * (length + 1) / 2.0;
+        unsuccessfulProbes += static_cast<double>(length) * length;
+    }
+
+    stats.expectedSuccessfulProbes = 1.0 + stats.loadFactor / 2.0;
+    stats.expectedUnsuccessfulProbes = 1.0 + stats.loadFactor;
+
+    if (count > 0)
+    {
+        stats.measuredSuccessfulProbes = successfulProbes / count;
+        stats.measuredUnsuccessfulProbes = unsuccessfulProbes / count;
+    }
+
+    return stats;
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int* HashSet<ElementType, Hasher>::makeBuckets(unsigned int capacity)
+{
+    unsigned int* buckets = new unsigned int[capacity];
+    std::fill(buckets, buckets + capacity, NO_NODE);
+    return buckets;
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int* HashSet<ElementType, Hasher>::copyBuckets(const unsigned int* buckets, unsigned int capacity)
+{
+    if (buckets == nullptr)
+    {
+        return nullptr;
+    }
+
+    unsigned int* copy = new unsigned int[capacity];
+    std::copy(buckets, buckets + capacity, copy);
+    return copy;
+}
+
+
+template <typename ElementType, typename Hasher>
+template <typename Key>
+bool HashSet<ElementType, Hasher>::matches(const Node& node, const Key& element) const
+{
+    if constexpr (STORES_CHARS)
+    {
+        return chars.view(node.element.offset, node.element.length) == element;
+    }
+    else
+    {
+        return node.element == element;
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+template <typename Key>
+unsigned int HashSet<ElementType, Hasher>::find(const Key& element, unsigned int hash) const
+{
+    if (capacity == 0)
+    {
+        return NO_NODE;
+    }
+
+    for (unsigned int n = buckets[hash % capacity]; n != NO_NODE; n = nodes[n].next)
+    {
+        if (nodes[n].hash == hash && matches(nodes[n], element))
+        {
+            return n;
+        }
+    }
+
+    if (oldBuckets != nullptr)
+    {
+        for (unsigned int n = oldBuckets[hash % oldCapacity]; n != NO_NODE; n = nodes[n].next)
+        {
+            if (nodes[n].hash == hash && matches(nodes[n], element))
+            {
+                return n;
+            }
+        }
+    }
+
+    return NO_NODE;
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::relinkChain(unsigned int& chain, unsigned int* buckets, unsigned int capacity) const noexcept
+{
+    unsigned int n = chain;
+
+    while (n != NO_NODE)
+    {
+        unsigned int next = nodes[n].next;
+        unsigned int index = nodes[n].hash % capacity;
+        nodes[n].next = buckets[index];
+        buckets[index] = n;
+        n = next;
+    }
+
+    chain = NO_NODE;
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::grow()
+{
+    finishMigration();
+
+    unsigned int newCapacity = capacity * 2 + 1;
+
+    if (resizing == HashSetResizing::Incremental && capacity > 0)
+    {
+        unsigned int* newBuckets = makeBuckets(newCapacity);
+
+        oldBuckets = buckets;
+        oldCapacity = capacity;
+        migrated = 0;
+
+        buckets = newBuckets;
+        capacity = newCapacity;
+    }
+    else
+    {
+        rehash(newCapacity);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::rehash(unsigned int newCapacity)
+{
+    finishMigration();
+
+    unsigned int* newBuckets = makeBuckets(newCapacity);
+
+    for (unsigned int i = 0; i < capacity; ++i)
+    {
+        relinkChain(buckets[i], newBuckets, newCapacity);
+    }
+
+    delete[] buckets;
+    buckets = newBuckets;
+    capacity = newCapacity;
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::migrate(unsigned int chains) const noexcept
+{
+    for (unsigned int i = 0; oldBuckets != nullptr && i < chains; ++i)
+    {
+        relinkChain(oldBuckets[migrated], buckets, capacity);
+        ++migrated;
+
+        if (migrated == oldCapacity)
+        {
+            delete[] oldBuckets;
+            oldBuckets = nullptr;
+            oldCapacity = 0;
+            migrated = 0;
+        }
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::finishMigration() const noexcept
+{
+    migrate(oldCapacity);
+}
+
+
+template <typename ElementType, typename Hasher>
+void HashSet<ElementType, Hasher>::swap(HashSet& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    nodes.swap(s.nodes);
+    chars.swap(s.chars);
+    std::swap(buckets, s.buckets);
+    std::swap(capacity, s.capacity);
+    std::swap(count, s.count);
+    std::swap(resizing, s.resizing);
+    std::swap(oldBuckets, s.oldBuckets);
+    std::swap(oldCapacity, s.oldCapacity);
+    std::swap(migrated, s.migrated);
+}
+
+
+
+#endif
@@ -0,0 +1,47 @@
+// HashSetStats.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A HashSetStats is a snapshot of the shape of a HashSet's array, as
+// returned by HashSet::stats().  It's meant for diagnosing hash functions:
+// a poor one shows up as a longest chain far beyond what the load factor
+// predicts, and as measured probe counts far above the expected ones.
+//
+// A "probe" is one node examined while walking a chain.  The measured
+// successful count averages the probes needed to find each element
+// actually stored.  The measured unsuccessful count assumes that missing
+// elements hash like the stored ones do, so a miss lands in each chain in
+// proportion to the number of elements that landed there, and walks that
+// entire chain.  The expected counts are what a uniformly-distributing
+// hash function would give at the same load factor a: 1 + a/2 for a
+// lookup that succeeds and, measured in that way, 1 + a for one that
+// fails.
+
+#ifndef HASHSETSTATS_HPP
+#define HASHSETSTATS_HPP
+
+#include <vector>
+
+
+
+struct HashSetStats
+{
+    unsigned int capacity;
+    unsigned int size;
+    double loadFactor;
+
+    // chainLengths[k] is the number of indices in the array whose chain
+    // has exactly k elements in it, for k from 0 up to longestChain.
+    std::vector<unsigned int> chainLengths;
+    unsigned int longestChain;
+
+    double expectedSuccessfulProbes;
+    double measuredSuccessfulProbes;
+    double expectedUnsuccessfulProbes;
+    double measuredUnsuccessfulProbes;
+};
+
+
+
+#endif
@@ -0,0 +1,503 @@
+// PerfectHashSet.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "PerfectHashSet.hpp"
+
+
+
+namespace
+{
+    // The largest pilot value; a bucket that none of 0 through MAX_PILOT
+    // can place causes the build to start over with another seed.
+    constexpr unsigned int MAX_PILOT = 0xffff;
+
+
+    // Scatters a pilot's bits across all 64, so that consecutive pilots
+    // send a string to unrelated slots.
+    inline std::uint64_t mixPilot(std::uint64_t pilot) noexcept
+    {
+        std::uint64_t x = (pilot + 1) * 0x9e3779b97f4a7c15ull;
+        return x ^ (x >> 29);
+    }
+
+
+    inline unsigned int slotFor(std::uint64_t hash, unsigned int pilot, unsigned int count) noexcept
+    {
+        return static_cast<unsigned int>((hash ^ mixPilot(pilot)) % count);
+    }
+
+
+    // Maps the high 32 bits of a hash to one of the given number of
+    // buckets, by multiplying rather than dividing.
+    inline unsigned int bucketFor(std::uint64_t hash, unsigned int buckets) noexcept
+    {
+        return static_cast<unsigned int>(((hash >> 32) * buckets) >> 32);
+    }
+
+
+    // Tries to find a pilot for every bucket, given every key's hash,
+    // storing each key's slot (from 0 to tableSize - 1) in slots.
+    // Returns false if some bucket can't be placed.
+    bool findPilots(
+        const std::vector<std::uint64_t>& hashes, unsigned int buckets, unsigned int tableSize,
+        std::uint16_t* pilots, std::vector<unsigned int>& slots)
+    {
+        unsigned int count = static_cast<unsigned int>(hashes.size());
+
+        // Group the keys by bucket (a counting sort), then order the
+        // buckets from largest to smallest, since the largest are the
+        // hardest to place and should go while most slots are free.
+        std::vector<unsigned int> bucketStart(buckets + 1, 0);
+
+        for (std::uint64_t hash : hashes)
+        {
+            ++bucketStart[bucketFor(hash, buckets) + 1];
+        }
+
+        unsigned int largest = 0;
+
+        for (unsigned int b = 0; b < buckets; ++b)
+        {
+            largest = std::max(largest, bucketStart[b + 1]);
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        std::vector<unsigned int> keys(count);
+        std::vector<unsigned int> next(bucketStart.begin(), bucketStart.end() - 1);
+
+        for (unsigned int k = 0; k < count; ++k)
+        {
+            keys[next[bucketFor(hashes[k], buckets)]++] = k;
+        }
+
+        std::vector<unsigned int> bySize(largest + 2, 0);
+
+        for (unsigned int b = 0; b < buckets; ++b)
+        {
+            ++bySize[largest - (bucketStart[b + 1] - bucketStart[b]) + 1];
+        }
+
+        for (unsigned int i = 1; i < bySize.size(); ++i)
+        {
+            bySize[i] += bySize[i - 1];
+        }
+
+        std::vector<unsigned int> order(buckets);
+
+        for (unsigned int b = 0; b < buckets; ++b)
+        {
+            order[bySize[largest - (bucketStart[b + 1] - bucketStart[b])]++] = b;
+        }
+
+        std::vector<bool> taken(tableSize, false);
+        std::vector<unsigned int> placed;
+
+        for (unsigned int b : order)
+        {
+            unsigned int first = bucketStart[b];
+            unsigned int last = bucketStart[b + 1];
+
+            if (first == last)
+            {
+                pilots[b] = 0;
+                continue;
+            }
+
+            bool found = false;
+
+            for (unsigned int pilot = 0; pilot <= MAX_PILOT && !found; ++pilot)
+            {
+                placed.clear();
+                found = true;
+
+                for (unsigned int i = first; i < last && found; ++i)
+                {
+                    unsigned int slot = slotFor(hashes[keys[i]], pilot, tableSize);
+
+                    if (taken[slot])
+                    {
+                        found = false;
+                    }
+                    else
+                    {
+                        taken[slot] = true;
+                        placed.push_back(slot);
+                    }
+                }
+
+                if (found)
+                {
+                    pilots[b] = static_cast<std::uint16_t>(pilot);
+
+                    for (unsigned int i = first; i < last; ++i)
+                    {
+                        slots[keys[i]] = placed[i - first];
+                    }
+                }
+                else
+                {
+                    for (unsigned int slot : placed)
+                    {
+                        taken[slot] = false;
+                    }
+                }
+            }
+
+            if (!found)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+
+
+PerfectHashSet::PerfectHashSet()
+    : count{0}, buckets{0}, tableSize{0}, seed{0},
+      pilots{nullptr}, remap{nullptr}, offsets{nullptr}, chars{nullptr},
+      pending{FastHash{}}, lastBuildMicroseconds{0.0}
+{
+}
+
+
+PerfectHashSet::~PerfectHashSet() noexcept
+{
+    delete[] pilots;
+    delete[] remap;
+    delete[] offsets;
+    delete[] chars;
+}
+
+
+PerfectHashSet::PerfectHashSet(const PerfectHashSet& s)
+    : count{s.count}, buckets{s.buckets}, tableSize{s.tableSize}, seed{s.seed},
+      pilots{nullptr}, remap{nullptr}, offsets{nullptr}, chars{nullptr},
+      pending{s.pending}, lastBuildMicroseconds{s.lastBuildMicroseconds}
+{
+    try
+    {
+        if (s.pilots != nullptr)
+        {
+            pilots = new std::uint16_t[buckets];
+            std::copy(s.pilots, s.pilots + buckets, pilots);
+        }
+
+        if (s.remap != nullptr)
+        {
+            remap = new unsigned int[tableSize - count];
+            std::copy(s.remap, s.remap + tableSize - count, remap);
+        }
+
+        if (s.offsets != nullptr)
+        {
+            offsets = new unsigned int[count + 1];
+            std::copy(s.offsets, s.offsets + count + 1, offsets);
+
+            chars = new char[offsets[count]];
+            std::copy(s.chars, s.chars + offsets[count], chars);
+        }
+    }
+    catch (...)
+    {
+        delete[] pilots;
+        delete[] remap;
+        delete[] offsets;
+        throw;
+    }
+}
+
+
+PerfectHashSet::PerfectHashSet(PerfectHashSet&& s) noexcept
+    : PerfectHashSet{}
+{
+    swap(s);
+}
+
+
+PerfectHashSet& PerfectHashSet::operator=(const PerfectHashSet& s)
+{
+    if (this != &s)
+    {
+        PerfectHashSet copy{s};
+        swap(copy);
+    }
+
+    return *this;
+}
+
+
+PerfectHashSet& PerfectHashSet::operator=(PerfectHashSet&& s) noexcept
+{
+    swap(s);
+    return *this;
+}
+
+
+bool PerfectHashSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void PerfectHashSet::add(const std::string& element)
+{
+    if (containsBuilt(element) || pending.contains(element))
+    {
+        return;
+    }
+
+    pending.add(element);
+}
+
+
+bool PerfectHashSet::contains(const std::string& element) const
+{
+    return contains(std::string_view{element});
+}
+
+
+bool PerfectHashSet::contains(std::string_view element) const
+{
+    return containsBuilt(element) || (pending.size() > 0 && pending.contains(element));
+}
+
+
+unsigned int PerfectHashSet::size() const noexcept
+{
+    return count + pending.size();
+}
+
+
+void PerfectHashSet::finishAdding()
+{
+    build();
+}
+
+
+void PerfectHashSet::build()
+{
+    if (pending.size() == 0)
+    {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::string_view> keys;
+    keys.reserve(size());
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        keys.push_back(slot(i));
+    }
+
+    pending.forEach([&](std::string_view key) { keys.push_back(key); });
+
+    unsigned int newCount = static_cast<unsigned int>(keys.size());
+    unsigned int newBuckets = (newCount + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+    unsigned int extraSlots = newCount / EXTRA_SLOTS_DIVISOR + 1;
+    unsigned int newTableSize = 0;
+    std::unique_ptr<std::uint16_t[]> newPilots;
+
+    std::vector<std::uint64_t> hashes(newCount);
+    std::vector<unsigned int> slots(newCount);
+    std::uint64_t newSeed = seed;
+    bool found = false;
+
+    for (unsigned int layout = 0; layout < MAX_LAYOUTS && !found; ++layout)
+    {
+        if (layout > 0)
+        {
+            // Every seed failed with this much room, so give each bucket
+            // fewer strings to place and more free slots to place them in.
+            newBuckets = std::min(newBuckets * 2, newCount);
+            extraSlots *= 2;
+        }
+
+        newTableSize = newCount + extraSlots;
+        newPilots.reset(new std::uint16_t[newBuckets]);
+
+        for (unsigned int attempt = 0; attempt < SEEDS_PER_LAYOUT && !found; ++attempt)
+        {
+            ++newSeed;
+            FastHash hasher{newSeed};
+
+            for (unsigned int k = 0; k < newCount; ++k)
+            {
+                hashes[k] = hasher.hash64(keys[k]);
+            }
+
+            found = findPilots(hashes, newBuckets, newTableSize, newPilots.get(), slots);
+        }
+    }
+
+    if (!found)
+    {
+        throw BuildException{};
+    }
+
+    // Move the keys in slots beyond the last one into the slots that were
+    // left empty, recording where each went.  The other entries of the
+    // remapping array only matter to strings not in the set, which will
+    // be compared to (and not match) whatever is in slot 0.
+    std::unique_ptr<unsigned int[]> newRemap{new unsigned int[newTableSize - newCount]};
+    std::fill(newRemap.get(), newRemap.get() + newTableSize - newCount, 0);
+    std::vector<bool> used(newCount, false);
+
+    for (unsigned int slot : slots)
+    {
+        if (slot < newCount)
+        {
+            used[slot] = true;
+        }
+    }
+
+    unsigned int nextFree = 0;
+
+    for (unsigned int k = 0; k < newCount; ++k)
+    {
+        if (slots[k] >= newCount)
+        {
+            while (used[nextFree])
+            {
+                ++nextFree;
+            }
+
+            used[nextFree] = true;
+            newRemap[slots[k] - newCount] = nextFree;
+            slots[k] = nextFree;
+        }
+    }
+
+    // Pack the characters in slot order.
+    std::vector<unsigned int> slotKeys(newCount);
+
+    for (unsigned int k = 0; k < newCount; ++k)
+    {
+        slotKeys[slots[k]] = k;
+    }
+
+    // Since every string is known by now, the characters are copied once
+    // into an array of exactly the right size.
+    std::unique_ptr<unsigned int[]> newOffsets{new unsigned int[newCount + 1]};
+    newOffsets[0] = 0;
+
+    for (unsigned int i = 0; i < newCount; ++i)
+    {
+        newOffsets[i + 1] = newOffsets[i] + static_cast<unsigned int>(keys[slotKeys[i]].length());
+    }
+
+    std::unique_ptr<char[]> newChars{new char[newOffsets[newCount]]};
+
+    for (unsigned int i = 0; i < newCount; ++i)
+    {
+        std::copy(keys[slotKeys[i]].begin(), keys[slotKeys[i]].end(), newChars.get() + newOffsets[i]);
+    }
+
+    delete[] pilots;
+    delete[] remap;
+    delete[] offsets;
+    delete[] chars;
+
+    count = newCount;
+    buckets = newBuckets;
+    tableSize = newTableSize;
+    seed = newSeed;
+    pilots = newPilots.release();
+    remap = newRemap.release();
+    offsets = newOffsets.release();
+    chars = newChars.release();
+
+    pending = HashSet<std::string, FastHash>{FastHash{}};
+
+    lastBuildMicroseconds = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+
+double PerfectHashSet::buildMicroseconds() const noexcept
+{
+    return lastBuildMicroseconds;
+}
+
+
+unsigned long long PerfectHashSet::bytes() const noexcept
+{
+    unsigned long long bytes = static_cast<unsigned long long>(buckets) * sizeof(std::uint16_t)
+        + static_cast<unsigned long long>(tableSize - count) * sizeof(unsigned int);
+
+    if (offsets != nullptr)
+    {
+        bytes += (static_cast<unsigned long long>(count) + 1) * sizeof(unsigned int) + offsets[count];
+    }
+
+    return bytes;
+}
+
+
+unsigned int PerfectHashSet::bucketCount() const noexcept
+{
+    return buckets;
+}
+
+
+std::uint64_t PerfectHashSet::hash(std::string_view element) const noexcept
+{
+    return FastHash{seed}.hash64(element);
+}
+
+
+unsigned int PerfectHashSet::bucketOf(std::uint64_t hash) const noexcept
+{
+    return bucketFor(hash, buckets);
+}
+
+
+unsigned int PerfectHashSet::slotOf(std::uint64_t hash, unsigned int bucket) const noexcept
+{
+    unsigned int slot = slotFor(hash, pilots[bucket], tableSize);
+    return slot < count ? slot : remap[slot - count];
+}
+
+
+std::string_view PerfectHashSet::slot(unsigned int index) const noexcept
+{
+    return std::string_view{chars + offsets[index], offsets[index + 1] - offsets[index]};
+}
+
+
+bool PerfectHashSet::containsBuilt(std::string_view element) const noexcept
+{
+    if (count == 0)
+    {
+        return false;
+    }
+
+    std::uint64_t h = hash(element);
+    return slot(slotOf(h, bucketOf(h))) == element;
+}
+
+
+void PerfectHashSet::swap(PerfectHashSet& s) noexcept
+{
+    std::swap(count, s.count);
+    std::swap(buckets, s.buckets);
+    std::swap(tableSize, s.tableSize);
+    std::swap(seed, s.seed);
+    std::swap(pilots, s.pilots);
+    std::swap(remap, s.remap);
+    std::swap(offsets, s.offsets);
+    std::swap(chars, s.chars);
+    std::swap(pending, s.pending);
+    std::swap(lastBuildMicroseconds, s.lastBuildMicroseconds);
+}
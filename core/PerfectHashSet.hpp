@@ -0,0 +1,138 @@
+// PerfectHashSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A PerfectHashSet is a set of strings meant to be built once and then
+// only searched, such as a dictionary that rarely changes.  It's built
+// around a minimal perfect hash function: one that maps each of its n
+// strings to a different index from 0 to n - 1, so that each string can
+// be stored in its own slot, with no chains, no empty slots, and no
+// collisions to resolve.  Looking a string up takes one hash, one slot,
+// and one comparison.
+//
+// The function is built "hash and displace" style (as in CHD or PTHash).
+// Every string's 64-bit FastHash picks one of about n / 5 buckets.  Then,
+// biggest bucket first, each bucket is given the smallest 16-bit "pilot"
+// value that sends all of its strings to slots no other string has taken,
+// where a string's slot is its hash, mixed with its bucket's pilot, modulo
+// a table size about 2% larger than n.  (Without that slack, the last few
+// buckets would have almost no free slots to find.)  The few strings that
+// land in slots n and beyond are then moved into the slots below n that
+// were left empty, and where each went is recorded in a small remapping
+// array.  Only the pilots (about 3.2 bits per string) and that array need
+// to be kept; if some bucket can't be placed with any pilot, the build
+// starts over with another seed for the hash function.  After a few seeds
+// fail, it also doubles the slack and the number of buckets, so that no
+// input can keep it trying forever.  Once every string has a slot, the
+// strings' characters are packed together in slot order, so that the
+// offset of each slot's characters is all that's stored for it.
+//
+// Elements passed to add() are held aside (in a HashSet, so duplicates
+// are ignored and contains() still finds them) until build() is called,
+// which addAll() does by way of finishAdding().  Building again after
+// more elements have been added rebuilds the whole structure.
+
+#ifndef PERFECTHASHSET_HPP
+#define PERFECTHASHSET_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "HashSet.hpp"
+#include "Set.hpp"
+#include "StringHashing.hpp"
+
+
+
+class PerfectHashSet : public Set<std::string>
+{
+public:
+    // The average number of strings in each bucket.
+    static constexpr unsigned int KEYS_PER_BUCKET = 5;
+
+    // The table has n / EXTRA_SLOTS_DIVISOR + 1 slots beyond n.
+    static constexpr unsigned int EXTRA_SLOTS_DIVISOR = 50;
+
+    // The number of seeds tried before the slack and the number of
+    // buckets are doubled, and the number of times that can happen before
+    // build() gives up by throwing a BuildException.
+    static constexpr unsigned int SEEDS_PER_LAYOUT = 8;
+    static constexpr unsigned int MAX_LAYOUTS = 8;
+
+    // A BuildException is thrown by build() if it can't find a perfect
+    // hash function, which (for distinct strings) is vanishingly unlikely.
+    class BuildException { };
+
+public:
+    PerfectHashSet();
+    ~PerfectHashSet() noexcept override;
+    PerfectHashSet(const PerfectHashSet& s);
+    PerfectHashSet(PerfectHashSet&& s) noexcept;
+    PerfectHashSet& operator=(const PerfectHashSet& s);
+    PerfectHashSet& operator=(PerfectHashSet&& s) noexcept;
+
+    bool isImplemented() const noexcept override;
+
+    // add() holds an element aside until the next call to build().
+    void add(const std::string& element) override;
+
+    using Set<std::string>::contains;
+
+    // contains() returns true if the given element is in the set, whether
+    // or not it's been built since the element was added.
+    bool contains(const std::string& element) const override;
+    bool contains(std::string_view element) const override;
+
+    unsigned int size() const noexcept override;
+
+    // finishAdding() calls build().
+    void finishAdding() override;
+
+    // build() builds the perfect hash function over every element added
+    // so far, if any have been added since the last time.
+    void build();
+
+    // buildMicroseconds() returns how long the last build() took.
+    double buildMicroseconds() const noexcept;
+
+    // bytes() returns the number of bytes occupied by the built structure:
+    // the pilots, the remapping array, the slots' offsets, and the packed
+    // characters.
+    unsigned long long bytes() const noexcept;
+
+    // bucketCount() returns the number of buckets (and, so, pilots).
+    unsigned int bucketCount() const noexcept;
+
+private:
+    // The built structure: slot i holds the characters of chars from
+    // offsets[i] up to (but not including) offsets[i + 1], and a string
+    // whose hash sends it to a slot s >= count is in slot remap[s - count].
+    unsigned int count;
+    unsigned int buckets;
+    unsigned int tableSize;
+    std::uint64_t seed;
+    std::uint16_t* pilots;
+    unsigned int* remap;
+    unsigned int* offsets;
+    char* chars;
+
+    // The elements added since the last build, whose characters build()
+    // reads straight out of the HashSet.
+    HashSet<std::string, FastHash> pending;
+
+    double lastBuildMicroseconds;
+
+    std::uint64_t hash(std::string_view element) const noexcept;
+    unsigned int bucketOf(std::uint64_t hash) const noexcept;
+    unsigned int slotOf(std::uint64_t hash, unsigned int bucket) const noexcept;
+    std::string_view slot(unsigned int index) const noexcept;
+
+    bool containsBuilt(std::string_view element) const noexcept;
+
+    void swap(PerfectHashSet& s) noexcept;
+};
+
+
+
+#endif
@@ -258,6 +258,10 @@ public:
     bool contains(const ElementType& element) const override;
 
 
+    // The std::string_view overload of contains() is inherited from Set.
+    using Set<ElementType>::contains;
+
+
     // size() returns the number of elements in the set.
     unsigned int size() const noexcept override;
 
@@ -0,0 +1,220 @@
+// SlabArena.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A SlabArena stores objects in a sequence of fixed-size "slabs," each a
+// dynamically-allocated array of SLAB_SIZE objects, and hands out indices
+// rather than pointers.  Allocation appends to the last slab (starting a
+// new one when it's full), so objects allocated one after another end up
+// next to each other in memory and nothing ever moves once allocated.
+// There is no way to free a single object; all of them are destroyed
+// together, one slab at a time.
+//
+// Because objects are referred to by index, a SlabArena can be copied slab
+// by slab, without needing to know how the objects refer to one another.
+
+#ifndef SLABARENA_HPP
+#define SLABARENA_HPP
+
+#include <algorithm>
+#include <utility>
+
+
+
+template <typename T>
+class SlabArena
+{
+public:
+    // The number of objects in each slab.
+    static constexpr unsigned int SLAB_SIZE = 1024;
+
+public:
+    SlabArena() noexcept;
+    ~SlabArena() noexcept;
+    SlabArena(const SlabArena& a);
+    SlabArena(SlabArena&& a) noexcept;
+    SlabArena& operator=(const SlabArena& a);
+    SlabArena& operator=(SlabArena&& a) noexcept;
+
+    // allocate() stores a copy of the given value in the arena and returns
+    // its index.  Indices are handed out consecutively, starting from 0.
+    unsigned int allocate(const T& value);
+
+    T& operator[](unsigned int index) noexcept;
+    const T& operator[](unsigned int index) const noexcept;
+
+    // size() returns the number of objects that have been allocated.
+    unsigned int size() const noexcept;
+
+    // bytes() returns the number of bytes occupied by the slabs.
+    unsigned long long bytes() const noexcept;
+
+    void swap(SlabArena& a) noexcept;
+
+private:
+    T** slabs;
+    unsigned int slabCount;
+    unsigned int slabCapacity;
+    unsigned int count;
+
+    void release() noexcept;
+};
+
+
+
+template <typename T>
+SlabArena<T>::SlabArena() noexcept
+    : slabs{nullptr}, slabCount{0}, slabCapacity{0}, count{0}
+{
+}
+
+
+template <typename T>
+SlabArena<T>::~SlabArena() noexcept
+{
+    release();
+}
+
+
+template <typename T>
+SlabArena<T>::SlabArena(const SlabArena& a)
+    : SlabArena{}
+{
+    if (a.slabCount == 0)
+    {
+        return;
+    }
+
+    slabs = new T*[a.slabCount];
+    slabCapacity = a.slabCount;
+
+    try
+    {
+        for (; slabCount < a.slabCount; ++slabCount)
+        {
+            slabs[slabCount] = new T[SLAB_SIZE];
+            std::copy(a.slabs[slabCount], a.slabs[slabCount] + SLAB_SIZE, slabs[slabCount]);
+        }
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+
+    count = a.count;
+}
+
+
+template <typename T>
+SlabArena<T>::SlabArena(SlabArena&& a) noexcept
+    : SlabArena{}
+{
+    swap(a);
+}
+
+
+template <typename T>
+SlabArena<T>& SlabArena<T>::operator=(const SlabArena& a)
+{
+    if (this != &a)
+    {
+        SlabArena copy{a};
+        swap(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename T>
+SlabArena<T>& SlabArena<T>::operator=(SlabArena&& a) noexcept
+{
+    swap(a);
+    return *this;
+}
+
+
+template <typename T>
+unsigned int SlabArena<T>::allocate(const T& value)
+{
+    if (count == slabCount * SLAB_SIZE)
+    {
+        if (slabCount == slabCapacity)
+        {
+            unsigned int newSlabCapacity = slabCapacity == 0 ? 4 : slabCapacity * 2;
+            T** newSlabs = new T*[newSlabCapacity];
+            std::copy(slabs, slabs + slabCount, newSlabs);
+
+            delete[] slabs;
+            slabs = newSlabs;
+            slabCapacity = newSlabCapacity;
+        }
+
+        slabs[slabCount] = new T[SLAB_SIZE];
+        ++slabCount;
+    }
+
+    (*this)[count] = value;
+    return count++;
+}
+
+
+template <typename T>
+T& SlabArena<T>::operator[](unsigned int index) noexcept
+{
+    return slabs[index / SLAB_SIZE][index % SLAB_SIZE];
+}
+
+
+template <typename T>
+const T& SlabArena<T>::operator[](unsigned int index) const noexcept
+{
+    return slabs[index / SLAB_SIZE][index % SLAB_SIZE];
+}
+
+
+template <typename T>
+unsigned int SlabArena<T>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename T>
+unsigned long long SlabArena<T>::bytes() const noexcept
+{
+    return static_cast<unsigned long long>(slabCount) * SLAB_SIZE * sizeof(T);
+}
+
+
+template <typename T>
+void SlabArena<T>::swap(SlabArena& a) noexcept
+{
+    std::swap(slabs, a.slabs);
+    std::swap(slabCount, a.slabCount);
+    std::swap(slabCapacity, a.slabCapacity);
+    std::swap(count, a.count);
+}
+
+
+template <typename T>
+void SlabArena<T>::release() noexcept
+{
+    for (unsigned int i = 0; i < slabCount; ++i)
+    {
+        delete[] slabs[i];
+    }
+
+    delete[] slabs;
+    slabs = nullptr;
+    slabCount = 0;
+    slabCapacity = 0;
+    count = 0;
+}
+
+
+
+#endif
+
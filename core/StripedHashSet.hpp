@@ -0,0 +1,574 @@
+// StripedHashSet.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A StripedHashSet is a separately-chained hash table that many threads
+// can add to (and search) at the same time.  Rather than one lock for the
+// whole table, it has a fixed number of "stripes," each a mutex; the chain
+// at index i is protected by stripe (i % stripeCount).  Because both the
+// capacity and the number of stripes are powers of two, with the capacity
+// never smaller, an element's stripe depends only on its hash and never
+// changes when the table grows, so two threads adding elements that land
+// on different stripes never wait for each other.
+//
+// Growth is the one operation that needs the whole table.  When an add()
+// pushes the ratio of size to capacity past 0.8, the thread that noticed
+// acquires every stripe, in order, doubles the capacity (unless another
+// thread got there first), and relinks every node before releasing them.
+// There's no shared count of elements for every add() to update; each
+// stripe counts its own, under its own mutex.  Since the hash spreads
+// elements evenly among the stripes, an add() estimates the size as its
+// stripe's count times the number of stripes, and only when that estimate
+// passes 0.8 does it sum the stripes' counts to check.
+//
+// addAllParallel() splits a range of elements among several threads, after
+// sizing the table once for all of them, which is the fast way to load a
+// large word list.
+//
+// Copying, moving, assigning, and destroying a StripedHashSet must not
+// happen while other threads are using it.
+
+#ifndef STRIPEDHASHSET_HPP
+#define STRIPEDHASHSET_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Set.hpp"
+
+
+
+template <typename ElementType, typename Hasher = std::function<unsigned int(const ElementType&)>>
+class StripedHashSet : public Set<ElementType>
+{
+public:
+    // The number of stripes used when none is specified.
+    static constexpr unsigned int DEFAULT_STRIPE_COUNT = 64;
+
+    // As in HashSet, the hash function is a std::function by default, but
+    // can be any function object type.
+    using HashFunction = Hasher;
+
+public:
+    // Initializes an empty StripedHashSet that uses the given hash function
+    // and at least the given number of stripes (rounded up to a power of
+    // two).
+    explicit StripedHashSet(
+        HashFunction hashFunction, unsigned int stripeCount = DEFAULT_STRIPE_COUNT);
+
+    ~StripedHashSet() noexcept override;
+    StripedHashSet(const StripedHashSet& s);
+    StripedHashSet(StripedHashSet&& s) noexcept;
+    StripedHashSet& operator=(const StripedHashSet& s);
+    StripedHashSet& operator=(StripedHashSet&& s) noexcept;
+
+    bool isImplemented() const noexcept override;
+
+    // add() adds an element to the set, holding only the element's stripe
+    // (or, when the table grows, every stripe).
+    void add(const ElementType& element) override;
+
+    using Set<ElementType>::contains;
+
+    // contains() returns true if the given element is in the set, holding
+    // only the element's stripe while it searches.
+    bool contains(const ElementType& element) const override;
+    bool contains(std::string_view element) const override;
+
+    unsigned int size() const noexcept override;
+
+    // reserve() grows the table once so that the given number of elements
+    // fit without exceeding the 0.8 ratio.
+    void reserve(unsigned int elementCount) override;
+
+    // addAllParallel() adds every element in the random-access range
+    // [begin, end), dividing the range evenly among the given number of
+    // threads.  The table is sized for the whole range before any of them
+    // start.
+    template <typename RandomAccessIterator>
+    void addAllParallel(RandomAccessIterator begin, RandomAccessIterator end, unsigned int threadCount);
+
+    // capacity() returns the number of chains in the table.
+    unsigned int capacity() const;
+
+    // stripeCount() returns the number of stripes.
+    unsigned int stripeCount() const noexcept;
+
+private:
+    struct Node
+    {
+        ElementType element;
+        unsigned int hash;
+        Node* next;
+    };
+
+    HashFunction hashFunction;
+
+    // One mutex per stripe, each on its own cache line so that threads
+    // holding different stripes don't contend for the same line.  The
+    // count of elements whose hash selects the stripe changes only while
+    // its mutex is held, but can be read at any time.
+    struct alignas(64) Stripe
+    {
+        std::mutex mutex;
+        std::atomic<unsigned int> count{0};
+    };
+
+    Stripe* stripes;
+    unsigned int stripes_;
+
+    // The table changes only while every stripe is held; any one stripe
+    // is enough to read it.
+    Node** buckets;
+    unsigned int capacity_;
+
+    template <typename Key>
+    bool find(const Key& element, unsigned int hash) const;
+
+    // Grows the table to the given capacity if it's still smaller.
+    void resize(unsigned int newCapacity);
+
+    void lockAll() const;
+    void unlockAll() const noexcept;
+
+    void copyFrom(const StripedHashSet& s);
+    void clear() noexcept;
+    void swap(StripedHashSet& s) noexcept;
+};
+
+
+
+namespace impl_
+{
+    template <typename ElementType>
+    unsigned int StripedHashSet__undefinedHashFunction(const ElementType& element)
+    {
+        return 0;
+    }
+
+
+    template <typename ElementType, typename Hasher>
+    Hasher StripedHashSet__movedFromHashFunction()
+    {
+        if constexpr (std::is_constructible_v<Hasher, unsigned int (*)(const ElementType&)>)
+        {
+            return Hasher{StripedHashSet__undefinedHashFunction<ElementType>};
+        }
+        else
+        {
+            return Hasher{};
+        }
+    }
+
+
+    inline unsigned int StripedHashSet__powerOfTwoAtLeast(unsigned int n)
+    {
+        unsigned int p = 1;
+
+        while (p < n)
+        {
+            p *= 2;
+        }
+
+        return p;
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+StripedHashSet<ElementType, Hasher>::StripedHashSet(HashFunction hashFunction, unsigned int stripeCount)
+    : hashFunction{hashFunction},
+      stripes{nullptr},
+      stripes_{impl_::StripedHashSet__powerOfTwoAtLeast(std::max(1u, stripeCount))},
+      buckets{nullptr},
+      capacity_{std::max(stripes_, 16u)}
+{
+    stripes = new Stripe[stripes_];
+    buckets = new Node*[capacity_];
+    std::fill(buckets, buckets + capacity_, nullptr);
+}
+
+
+template <typename ElementType, typename Hasher>
+StripedHashSet<ElementType, Hasher>::~StripedHashSet() noexcept
+{
+    clear();
+    delete[] stripes;
+}
+
+
+template <typename ElementType, typename Hasher>
+StripedHashSet<ElementType, Hasher>::StripedHashSet(const StripedHashSet& s)
+    : hashFunction{s.hashFunction},
+      stripes{new Stripe[s.stripes_]},
+      stripes_{s.stripes_},
+      buckets{nullptr},
+      capacity_{0}
+{
+    try
+    {
+        copyFrom(s);
+    }
+    catch (...)
+    {
+        clear();
+        delete[] stripes;
+        throw;
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+StripedHashSet<ElementType, Hasher>::StripedHashSet(StripedHashSet&& s) noexcept
+    : hashFunction{impl_::StripedHashSet__movedFromHashFunction<ElementType, Hasher>()},
+      stripes{nullptr},
+      stripes_{0},
+      buckets{nullptr},
+      capacity_{0}
+{
+    swap(s);
+}
+
+
+template <typename ElementType, typename Hasher>
+StripedHashSet<ElementType, Hasher>& StripedHashSet<ElementType, Hasher>::operator=(const StripedHashSet& s)
+{
+    if (this != &s)
+    {
+        StripedHashSet copy{s};
+        swap(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType, typename Hasher>
+StripedHashSet<ElementType, Hasher>& StripedHashSet<ElementType, Hasher>::operator=(StripedHashSet&& s) noexcept
+{
+    swap(s);
+    return *this;
+}
+
+
+template <typename ElementType, typename Hasher>
+bool StripedHashSet<ElementType, Hasher>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::add(const ElementType& element)
+{
+    if (stripes_ == 0)
+    {
+        *this = StripedHashSet{hashFunction};
+    }
+
+    unsigned int hash = hashFunction(element);
+    Stripe& stripe = stripes[hash & (stripes_ - 1)];
+    unsigned int stripeSize;
+    unsigned int observedCapacity;
+
+    {
+        std::lock_guard<std::mutex> lock{stripe.mutex};
+
+        if (find(element, hash))
+        {
+            return;
+        }
+
+        unsigned int index = hash & (capacity_ - 1);
+        buckets[index] = new Node{element, hash, buckets[index]};
+        observedCapacity = capacity_;
+
+        stripeSize = stripe.count.load(std::memory_order_relaxed) + 1;
+        stripe.count.store(stripeSize, std::memory_order_relaxed);
+    }
+
+    if (static_cast<double>(stripeSize) * stripes_ / observedCapacity > 0.8
+        && static_cast<double>(size()) / observedCapacity > 0.8)
+    {
+        resize(observedCapacity * 2);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+bool StripedHashSet<ElementType, Hasher>::contains(const ElementType& element) const
+{
+    if (stripes_ == 0)
+    {
+        return false;
+    }
+
+    unsigned int hash = hashFunction(element);
+    std::lock_guard<std::mutex> lock{stripes[hash & (stripes_ - 1)].mutex};
+    return find(element, hash);
+}
+
+
+template <typename ElementType, typename Hasher>
+bool StripedHashSet<ElementType, Hasher>::contains(std::string_view element) const
+{
+    if constexpr (std::is_invocable_r_v<unsigned int, const Hasher&, std::string_view>
+                  && std::is_convertible_v<const ElementType&, std::string_view>)
+    {
+        if (stripes_ == 0)
+        {
+            return false;
+        }
+
+        unsigned int hash = hashFunction(element);
+        std::lock_guard<std::mutex> lock{stripes[hash & (stripes_ - 1)].mutex};
+        return find(element, hash);
+    }
+    else if constexpr (std::is_same_v<ElementType, std::string>)
+    {
+        thread_local std::string scratch;
+        scratch.assign(element.data(), element.size());
+        return contains(scratch);
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int StripedHashSet<ElementType, Hasher>::size() const noexcept
+{
+    unsigned int total = 0;
+
+    for (unsigned int i = 0; i < stripes_; ++i)
+    {
+        total += stripes[i].count.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::reserve(unsigned int elementCount)
+{
+    unsigned int newCapacity = std::max(capacity_, 16u);
+
+    while (static_cast<double>(elementCount) / newCapacity > 0.8)
+    {
+        newCapacity *= 2;
+    }
+
+    resize(newCapacity);
+}
+
+
+template <typename ElementType, typename Hasher>
+template <typename RandomAccessIterator>
+void StripedHashSet<ElementType, Hasher>::addAllParallel(
+    RandomAccessIterator begin, RandomAccessIterator end, unsigned int threadCount)
+{
+    auto length = std::distance(begin, end);
+
+    reserve(size() + static_cast<unsigned int>(length));
+
+    threadCount = std::max(1u, threadCount);
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 0; t < threadCount; ++t)
+    {
+        RandomAccessIterator first = begin + length * t / threadCount;
+        RandomAccessIterator last = begin + length * (t + 1) / threadCount;
+
+        threads.emplace_back(
+            [this, first, last]()
+            {
+                for (RandomAccessIterator i = first; i != last; ++i)
+                {
+                    add(*i);
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int StripedHashSet<ElementType, Hasher>::capacity() const
+{
+    if (stripes_ == 0)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock{stripes[0].mutex};
+    return capacity_;
+}
+
+
+template <typename ElementType, typename Hasher>
+unsigned int StripedHashSet<ElementType, Hasher>::stripeCount() const noexcept
+{
+    return stripes_;
+}
+
+
+template <typename ElementType, typename Hasher>
+template <typename Key>
+bool StripedHashSet<ElementType, Hasher>::find(const Key& element, unsigned int hash) const
+{
+    for (const Node* n = buckets[hash & (capacity_ - 1)]; n != nullptr; n = n->next)
+    {
+        if (n->hash == hash && n->element == element)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::resize(unsigned int newCapacity)
+{
+    lockAll();
+
+    if (newCapacity > capacity_)
+    {
+        Node** newBuckets;
+
+        try
+        {
+            newBuckets = new Node*[newCapacity];
+        }
+        catch (...)
+        {
+            unlockAll();
+            throw;
+        }
+
+        std::fill(newBuckets, newBuckets + newCapacity, nullptr);
+
+        for (unsigned int i = 0; i < capacity_; ++i)
+        {
+            Node* n = buckets[i];
+
+            while (n != nullptr)
+            {
+                Node* next = n->next;
+                unsigned int index = n->hash & (newCapacity - 1);
+                n->next = newBuckets[index];
+                newBuckets[index] = n;
+                n = next;
+            }
+        }
+
+        delete[] buckets;
+        buckets = newBuckets;
+        capacity_ = newCapacity;
+    }
+
+    unlockAll();
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::lockAll() const
+{
+    for (unsigned int i = 0; i < stripes_; ++i)
+    {
+        stripes[i].mutex.lock();
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::unlockAll() const noexcept
+{
+    for (unsigned int i = stripes_; i > 0; --i)
+    {
+        stripes[i - 1].mutex.unlock();
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::copyFrom(const StripedHashSet& s)
+{
+    buckets = new Node*[s.capacity_];
+    capacity_ = s.capacity_;
+    std::fill(buckets, buckets + capacity_, nullptr);
+
+    for (unsigned int i = 0; i < capacity_; ++i)
+    {
+        Node** tail = &buckets[i];
+
+        for (const Node* n = s.buckets[i]; n != nullptr; n = n->next)
+        {
+            *tail = new Node{n->element, n->hash, nullptr};
+            tail = &(*tail)->next;
+        }
+    }
+
+    for (unsigned int i = 0; i < stripes_; ++i)
+    {
+        stripes[i].count.store(s.stripes[i].count.load());
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::clear() noexcept
+{
+    for (unsigned int i = 0; i < capacity_; ++i)
+    {
+        Node* n = buckets[i];
+
+        while (n != nullptr)
+        {
+            Node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    delete[] buckets;
+    buckets = nullptr;
+    capacity_ = 0;
+
+    for (unsigned int i = 0; i < stripes_; ++i)
+    {
+        stripes[i].count.store(0);
+    }
+}
+
+
+template <typename ElementType, typename Hasher>
+void StripedHashSet<ElementType, Hasher>::swap(StripedHashSet& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(stripes, s.stripes);
+    std::swap(stripes_, s.stripes_);
+    std::swap(buckets, s.buckets);
+    std::swap(capacity_, s.capacity_);
+}
+
+
+
+#endif
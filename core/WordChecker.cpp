@@ -6,29 +6,219 @@
 // Replace and/or augment the implementations below as needed to meet
 // the requirements.
 
+#include <algorithm>
+#include <string_view>
 #include "WordChecker.hpp"
 
 
 
+namespace
+{
+    constexpr std::string_view LETTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+
+    void addSuggestion(std::vector<std::string>& suggestions, std::string_view suggestion)
+    {
+        if (std::find(suggestions.begin(), suggestions.end(), suggestion) == suggestions.end())
+        {
+            suggestions.emplace_back(suggestion);
+        }
+    }
+}
+
+
+
 WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+    : words{words},
+      productHashSet{dynamic_cast<const HashSet<std::string, ProductHash>*>(&words)},
+      productFunctionSet{nullptr},
+      orderedSet{dynamic_cast<const AVLSet<std::string>*>(&words)}
 {
+    auto functionSet = dynamic_cast<const HashSet<std::string>*>(&words);
+
+    if (functionSet != nullptr)
+    {
+        auto function = functionSet->hasher().target<unsigned int (*)(const std::string&)>();
+
+        if (function != nullptr && *function == hashStringAsProduct)
+        {
+            productFunctionSet = functionSet;
+        }
+    }
 }
 
 
 bool WordChecker::wordExists(const std::string& word) const
 {
-    return false;
+    return words.contains(word);
 }
 
 
 std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
 {
-    // Nonsensical code because the compiler requires the member variables
-    // 'words' to be used somewhere, or else it becomes a warning (which
-    // turns into an error).
-    words.isImplemented();
+    std::vector<std::string> suggestions;
+
+    // Every candidate is built in this one buffer and looked up through a
+    // std::string_view, so that a std::string is only created for the
+    // candidates that turn out to be words.
+    std::string candidate;
+    candidate.reserve(word.length() + 1);
+
+    // Each candidate's hash is derived from the word's in constant time;
+    // it's only used when the words are in a HashSet that hashes them the
+    // same way.
+    thread_local RollingProductHash hashes;
+    hashes.assign(word);
+
+    // No edit after this position can produce a word, because no word
+    // begins with the characters before it.
+    std::size_t reach = longestWordPrefix(word);
+
+    auto consider = [&](unsigned int hash)
+    {
+        if (containsCandidate(candidate, hash))
+        {
+            addSuggestion(suggestions, candidate);
+        }
+    };
+
+    // Swapping each adjacent pair of characters
+    candidate = word;
+
+    for (size_t i = 0; i + 1 < word.length() && i <= reach; ++i)
+    {
+        std::swap(candidate[i], candidate[i + 1]);
+        consider(hashes.swapped(i));
+        std::swap(candidate[i], candidate[i + 1]);
+    }
+
+    // Inserting each letter in between each adjacent pair of characters,
+    // as well as at the beginning and end.  Which letters some word has
+    // at each position (after the word's characters before it) is noted
+    // along the way, so that replacing can skip the others.
+    std::vector<unsigned int> lettersThatBeginWords(word.length() + 1, 0);
+
+    for (size_t i = 0; i <= word.length() && i <= reach; ++i)
+    {
+        candidate.assign(word, 0, i);
+        candidate.push_back(' ');
+        candidate.append(word, i, std::string::npos);
+
+        for (size_t l = 0; l < LETTERS.length(); ++l)
+        {
+            candidate[i] = LETTERS[l];
+
+            if (beginsAnyWord(std::string_view{candidate}.substr(0, i + 1)))
+            {
+                lettersThatBeginWords[i] |= 1u << l;
+                consider(hashes.inserted(i, LETTERS[l]));
+            }
+        }
+    }
+
+    // Deleting each character
+    for (size_t i = 0; i < word.length() && i <= reach; ++i)
+    {
+        candidate.assign(word, 0, i);
+        candidate.append(word, i + 1, std::string::npos);
+        consider(hashes.erased(i));
+    }
+
+    // Replacing each character with each letter
+    candidate = word;
+
+    for (size_t i = 0; i < word.length() && i <= reach; ++i)
+    {
+        for (size_t l = 0; l < LETTERS.length(); ++l)
+        {
+            if (LETTERS[l] != word[i] && (lettersThatBeginWords[i] & (1u << l)) != 0)
+            {
+                candidate[i] = LETTERS[l];
+                consider(hashes.replaced(i, LETTERS[l]));
+            }
+        }
 
-    return std::vector<std::string>{};
+        candidate[i] = word[i];
+    }
+
+    // Splitting into a pair of words by adding a space in between
+    std::string_view view{word};
+
+    for (size_t i = 1; i < word.length() && i <= reach; ++i)
+    {
+        if (containsCandidate(view.substr(0, i), hashes.substring(0, i))
+            && containsCandidate(view.substr(i), hashes.substring(i, word.length() - i)))
+        {
+            candidate.assign(word, 0, i);
+            candidate.push_back(' ');
+            candidate.append(word, i, std::string::npos);
+            addSuggestion(suggestions, candidate);
+        }
+    }
+
+    return suggestions;
 }
 
+
+bool WordChecker::containsCandidate(std::string_view candidate, unsigned int hash) const
+{
+    if (productHashSet != nullptr)
+    {
+        return productHashSet->containsWithHash(candidate, hash);
+    }
+    else if (productFunctionSet != nullptr)
+    {
+        return productFunctionSet->containsWithHash(candidate, hash);
+    }
+    else
+    {
+        return words.contains(candidate);
+    }
+}
+
+
+std::size_t WordChecker::longestWordPrefix(const std::string& word) const
+{
+    if (orderedSet == nullptr)
+    {
+        return word.length();
+    }
+
+    // The words that share the longest prefix with this one include the
+    // words just before and just after where it would be in order.
+    auto sharedPrefix = [&](const std::string& other)
+    {
+        return static_cast<std::size_t>(
+            std::mismatch(word.begin(), word.end(), other.begin(), other.end()).first - word.begin());
+    };
+
+    auto after = orderedSet->lower_bound(word);
+    auto before = after;
+    --before;
+
+    std::size_t longest = 0;
+
+    if (after != orderedSet->end())
+    {
+        longest = sharedPrefix(*after);
+    }
+
+    if (before != orderedSet->end())
+    {
+        longest = std::max(longest, sharedPrefix(*before));
+    }
+
+    return longest;
+}
+
+
+bool WordChecker::beginsAnyWord(std::string_view prefix) const
+{
+    if (orderedSet == nullptr)
+    {
+        return true;
+    }
+
+    auto first = orderedSet->lower_bound(prefix);
+    return first != orderedSet->end() && std::string_view{*first}.substr(0, prefix.length()) == prefix;
+}
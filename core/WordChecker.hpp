@@ -17,8 +17,12 @@
 #define WORDCHECKER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
 #include "Set.hpp"
+#include "StringHashing.hpp"
 
 
 
@@ -44,6 +48,34 @@ public:
 
 private:
     const Set<std::string>& words;
+
+    // When the words are in a HashSet that hashes them with
+    // hashStringAsProduct() (or ProductHash), one of these points to it,
+    // and the hash of each suggestion candidate is calculated from the
+    // misspelled word's hash with a RollingProductHash, rather than from
+    // scratch, so that looking a candidate up only searches one chain.
+    const HashSet<std::string, ProductHash>* productHashSet;
+    const HashSet<std::string>* productFunctionSet;
+
+    // When the words are in an AVLSet, this points to it, and candidates
+    // are only looked up when some word begins the way they do: an edit
+    // at position i can only produce a word if the misspelled word's
+    // first i characters begin one, and inserting or replacing with a
+    // letter there only if those characters followed by the letter do.
+    const AVLSet<std::string>* orderedSet;
+
+    // Returns true if the given candidate, whose product hash is given, is
+    // in the set of words.
+    bool containsCandidate(std::string_view candidate, unsigned int hash) const;
+
+    // Returns the length of the longest prefix of the given word that
+    // begins some word in the set (or the word's length, if the set can't
+    // say).
+    std::size_t longestWordPrefix(const std::string& word) const;
+
+    // Returns true if some word in the set begins with the given prefix
+    // (or, if the set can't say, always).
+    bool beginsAnyWord(std::string_view prefix) const;
 };
 
 
@@ -0,0 +1,133 @@
+// AVLMemoryBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "ArenaAVLSet.hpp"
+#include "BTreeSet.hpp"
+#include "Benchmarks.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    // Every word is looked up this many times over.
+    constexpr unsigned int ROUNDS = 10;
+
+
+    // The number of bytes glibc's malloc sets aside for a request of the
+    // given size: the request plus an 8-byte header, rounded up to a
+    // multiple of 16, and never less than 32.
+    unsigned long long heapBlockBytes(unsigned long long requested)
+    {
+        return std::max(32ull, (requested + 8 + 15) / 16 * 16);
+    }
+
+
+    // AVLSet doesn't track its own memory, so this adds up what it must
+    // have allocated: one block per node, plus one per string too long to
+    // be stored inside the std::string itself.
+    unsigned long long avlSetBytes(const std::vector<std::string>& words)
+    {
+        const std::size_t inlineCapacity = std::string{}.capacity();
+        unsigned long long bytes = 0;
+
+        for (const std::string& word : words)
+        {
+            bytes += heapBlockBytes(sizeof(AvlNode<std::string>));
+
+            if (word.length() > inlineCapacity)
+            {
+                bytes += heapBlockBytes(word.length() + 1);
+            }
+        }
+
+        return bytes;
+    }
+
+
+    template <typename SetType>
+    double lookupsPerSecond(const SetType& set, const std::vector<std::string>& lookups)
+    {
+        unsigned int found = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned int round = 0; round < ROUNDS; ++round)
+        {
+            for (const std::string& word : lookups)
+            {
+                found += set.contains(word) ? 1 : 0;
+            }
+        }
+
+        auto stop = std::chrono::steady_clock::now();
+
+        if (found != lookups.size() * ROUNDS)
+        {
+            std::cout << "(some words were not found)" << std::endl;
+        }
+
+        return lookups.size() * ROUNDS / std::chrono::duration<double>(stop - start).count();
+    }
+
+
+    void printRow(
+        const std::string& name, unsigned long long bytes, std::size_t words,
+        double lookups, double baseline)
+    {
+        std::cout << std::left << std::setw(14) << name;
+        std::cout << std::right << std::fixed
+                  << std::setw(14) << bytes
+                  << std::setprecision(1) << std::setw(12) << static_cast<double>(bytes) / words
+                  << std::setprecision(0) << std::setw(16) << lookups
+                  << std::setprecision(2) << std::setw(10) << lookups / baseline << std::endl;
+    }
+}
+
+
+
+void runAVLMemoryBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+
+    std::cout << "Loading " << words.size() << " words into each tree ..." << std::endl;
+
+    AVLSet<std::string> pointers;
+    ArenaAVLSet<std::string> arena;
+    BTreeSet<std::string> bTree;
+
+    for (const std::string& word : words)
+    {
+        pointers.add(word);
+        arena.add(word);
+    }
+
+    bTree.addSorted(words.begin(), words.end());
+
+    std::vector<std::string> lookups = words;
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937{46});
+
+    double pointerLookups = lookupsPerSecond(pointers, lookups);
+    double arenaLookups = lookupsPerSecond(arena, lookups);
+    double bTreeLookups = lookupsPerSecond(bTree, lookups);
+
+    std::cout << std::endl;
+    std::cout << "RESULTS" << std::endl;
+    std::cout << "                       Bytes  Bytes/word     Lookups/sec   Speedup" << std::endl;
+
+    printRow("AVLSet", avlSetBytes(words), words.size(), pointerLookups, pointerLookups);
+    printRow("ArenaAVLSet", arena.bytes(), words.size(), arenaLookups, pointerLookups);
+    printRow("BTreeSet", bTree.bytes(), words.size(), bTreeLookups, pointerLookups);
+}
@@ -0,0 +1,132 @@
+// AddLatencyBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    // After the word file itself, the words are suffixed with the number
+    // of the copy they came from (as in the PARALLEL LOAD benchmark) until
+    // there are this many distinct ones, so that the HashSet resizes from
+    // millions of elements and not only from tens of thousands.
+    constexpr std::size_t SYNTHETIC_WORD_COUNT = 4000000;
+
+
+    std::vector<std::string> makeSyntheticWords(const std::vector<std::string>& loaded)
+    {
+        std::vector<std::string> words;
+
+        if (loaded.empty())
+        {
+            return words;
+        }
+
+        words.reserve(SYNTHETIC_WORD_COUNT);
+
+        for (unsigned int c = 0; words.size() < SYNTHETIC_WORD_COUNT; ++c)
+        {
+            for (const std::string& word : loaded)
+            {
+                if (words.size() == SYNTHETIC_WORD_COUNT)
+                {
+                    break;
+                }
+
+                words.push_back(c == 0 ? word : word + std::to_string(c));
+            }
+        }
+
+        return words;
+    }
+
+
+    std::vector<long long> measureAdds(
+        const std::vector<std::string>& words, HashSetResizing resizing)
+    {
+        HashSet<std::string> set{hashStringAsProduct, resizing};
+        std::vector<long long> latencies;
+        latencies.reserve(words.size());
+
+        for (const std::string& word : words)
+        {
+            auto start = std::chrono::steady_clock::now();
+            set.add(word);
+            auto stop = std::chrono::steady_clock::now();
+
+            latencies.push_back(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        }
+
+        return latencies;
+    }
+
+
+    void printLatencies(const std::string& name, std::vector<long long> latencies)
+    {
+        std::sort(latencies.begin(), latencies.end());
+
+        long long total = 0;
+
+        for (long long latency : latencies)
+        {
+            total += latency;
+        }
+
+        double mean = latencies.empty() ? 0.0 : static_cast<double>(total) / latencies.size();
+        long long p99 = latencies.empty() ? 0 : latencies[latencies.size() * 99 / 100];
+        long long max = latencies.empty() ? 0 : latencies.back();
+
+        std::cout << std::left << std::setw(14) << name;
+        std::cout << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(10) << total / 1000 << "usec"
+                  << std::setw(10) << mean << "nsec"
+                  << std::setw(10) << p99 << "nsec"
+                  << std::setw(12) << max << "nsec" << std::endl;
+    }
+
+
+    void runAndPrintLatencies(const std::vector<std::string>& words)
+    {
+        std::cout << "Timing " << words.size() << " adds into HashSet ..." << std::endl;
+
+        std::vector<long long> allAtOnce = measureAdds(words, HashSetResizing::AllAtOnce);
+        std::vector<long long> incremental = measureAdds(words, HashSetResizing::Incremental);
+
+        std::cout << std::endl;
+        std::cout << "RESULTS" << std::endl;
+        std::cout << "                   Total          Mean           p99             Max" << std::endl;
+
+        printLatencies("AllAtOnce", allAtOnce);
+        printLatencies("Incremental", incremental);
+    }
+}
+
+
+
+void runAddLatencyBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+
+    runAndPrintLatencies(words);
+
+    std::cout << std::endl;
+    runAndPrintLatencies(makeSyntheticWords(words));
+}
+
@@ -0,0 +1,129 @@
+// AdversarialHashBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+
+
+
+namespace
+{
+    // "BA" and "Af" have the same product hash (66 * 37 + 65 and
+    // 65 * 37 + 102 are both 2507), and since the product hash of a
+    // string is a polynomial, so does every string made of the same
+    // number of those blocks in any order.  n blocks make 2^n words that
+    // all land in one chain of a HashSet using hashStringAsProduct().
+    std::vector<std::string> makeCollidingWords(unsigned int blocks)
+    {
+        std::vector<std::string> words;
+
+        for (unsigned long i = 0; i < (1ul << blocks); ++i)
+        {
+            std::string word;
+
+            for (unsigned int b = 0; b < blocks; ++b)
+            {
+                word += (i >> b) & 1 ? "Af" : "BA";
+            }
+
+            words.push_back(word);
+        }
+
+        return words;
+    }
+
+
+    struct Latencies
+    {
+        double mean;
+        long long max;
+    };
+
+
+    template <typename Hasher>
+    Latencies measureLookups(const HashSet<std::string, Hasher>& set, const std::vector<std::string>& words)
+    {
+        long long total = 0;
+        long long max = 0;
+
+        for (const std::string& word : words)
+        {
+            auto start = std::chrono::steady_clock::now();
+            set.contains(word);
+            auto stop = std::chrono::steady_clock::now();
+
+            long long latency = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+            total += latency;
+            max = std::max(max, latency);
+        }
+
+        return Latencies{static_cast<double>(total) / std::max<std::size_t>(1, words.size()), max};
+    }
+
+
+    template <typename Hasher>
+    void runOn(
+        const std::string& name, Hasher hasher,
+        const std::vector<std::string>& words, const std::vector<std::string>& missing)
+    {
+        auto start = std::chrono::steady_clock::now();
+        HashSet<std::string, Hasher> set{hasher, words.begin(), words.end()};
+        auto stop = std::chrono::steady_clock::now();
+
+        Latencies hits = measureLookups(set, words);
+        Latencies misses = measureLookups(set, missing);
+
+        std::cout << std::left << std::setw(14) << name;
+        std::cout << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(10) << std::chrono::duration<double, std::micro>(stop - start).count() << "usec"
+                  << std::setw(10) << hits.mean << "nsec"
+                  << std::setw(10) << hits.max << "nsec"
+                  << std::setw(10) << misses.mean << "nsec"
+                  << std::setw(10) << misses.max << "nsec"
+                  << std::setw(10) << set.stats().longestChain << std::endl;
+    }
+}
+
+
+
+void runAdversarialHashBenchmark()
+{
+    std::string blocksLine;
+    std::getline(std::cin, blocksLine);
+
+    unsigned int blocks = std::min(20, std::max(2, std::atoi(blocksLine.c_str())));
+
+    // Half the colliding words are loaded into the set; the other half
+    // (those beginning with "Af") are missing from it, but collide with
+    // every word that isn't.
+    std::vector<std::string> words;
+    std::vector<std::string> missing;
+
+    for (std::string& word : makeCollidingWords(blocks))
+    {
+        (word[0] == 'B' ? words : missing).push_back(std::move(word));
+    }
+
+    std::cout << "Loading and looking up " << words.size()
+              << " words whose product hashes all collide ..." << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "RESULTS" << std::endl;
+    std::cout << "Hash               LoadTime      HitMean       HitMax     MissMean      MissMax  Longest" << std::endl;
+
+    runOn<std::function<unsigned int(const std::string&)>>("PRODUCT", hashStringAsProduct, words, missing);
+    runOn("FAST", FastHash{}, words, missing);
+    runOn("FAST SEEDED", FastHash{processHashSeed()}, words, missing);
+    runOn("SIP", SipHash{}, words, missing);
+}
@@ -0,0 +1,178 @@
+// BatchHashBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    // Candidates are generated from this many words of the word file.
+    constexpr std::size_t SOURCE_WORDS = 3000;
+
+    // Every measurement hashes (or looks up) every candidate this many
+    // times over.
+    constexpr unsigned int ROUNDS = 10;
+
+
+    // Generates the candidates WordChecker would for each word by
+    // inserting or replacing one letter, a batch of 26 same-length
+    // candidates per position.
+    std::vector<std::string> makeCandidates(const std::vector<std::string>& words)
+    {
+        std::vector<std::string> candidates;
+
+        for (std::size_t w = 0; w < words.size() && w < SOURCE_WORDS; ++w)
+        {
+            const std::string& word = words[w];
+
+            for (std::size_t i = 0; i <= word.length(); ++i)
+            {
+                for (char letter = 'A'; letter <= 'Z'; ++letter)
+                {
+                    candidates.push_back(word.substr(0, i) + letter + word.substr(i));
+                }
+            }
+
+            for (std::size_t i = 0; i < word.length(); ++i)
+            {
+                for (char letter = 'A'; letter <= 'Z'; ++letter)
+                {
+                    std::string candidate = word;
+                    candidate[i] = letter;
+                    candidates.push_back(candidate);
+                }
+            }
+        }
+
+        return candidates;
+    }
+
+
+    template <typename Function>
+    double perSecond(std::size_t count, Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned int round = 0; round < ROUNDS; ++round)
+        {
+            function();
+        }
+
+        auto stop = std::chrono::steady_clock::now();
+        return count * ROUNDS / std::chrono::duration<double>(stop - start).count();
+    }
+
+
+    void printRate(const std::string& name, double rate, double baseline)
+    {
+        std::cout << std::left << std::setw(26) << name;
+        std::cout << std::right << std::fixed << std::setprecision(0) << std::setw(16) << rate
+                  << std::setprecision(2) << std::setw(10) << rate / baseline << std::endl;
+    }
+}
+
+
+
+void runBatchHashBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+    std::vector<std::string> candidates = makeCandidates(words);
+    std::vector<std::string_view> views{candidates.begin(), candidates.end()};
+
+    std::vector<unsigned int> hashes(views.size());
+    std::unique_ptr<bool[]> results{new bool[views.size()]};
+    volatile unsigned int sink = 0;
+
+    std::cout << "Hashing and looking up " << views.size() << " candidates ..." << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "RESULTS" << std::endl;
+    std::cout << "Hashing                      Candidates/sec   Speedup" << std::endl;
+
+    double scalarLoop = perSecond(
+        views.size(),
+        [&]()
+        {
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                hashes[i] = ProductHash{}(views[i]);
+            }
+
+            sink = sink + hashes.back();
+        });
+
+    printRate("Scalar loop", scalarLoop, scalarLoop);
+
+    printRate(
+        "hashMany (scalar)",
+        perSecond(
+            views.size(),
+            [&]() { impl_::StringHashing__hashManyScalar(views.data(), views.size(), hashes.data()); }),
+        scalarLoop);
+
+#ifdef __SSE2__
+    printRate(
+        "hashMany (SSE2)",
+        perSecond(
+            views.size(),
+            [&]() { impl_::StringHashing__hashManySse2(views.data(), views.size(), hashes.data()); }),
+        scalarLoop);
+#endif
+
+#ifdef STRINGHASHING_AVX2_KERNEL
+    if (impl_::StringHashing__avx2Supported())
+    {
+        printRate(
+            "hashMany (AVX2)",
+            perSecond(
+                views.size(),
+                [&]() { impl_::StringHashing__hashManyAvx2(views.data(), views.size(), hashes.data()); }),
+            scalarLoop);
+    }
+#endif
+
+    HashSet<std::string, ProductHash> set{ProductHash{}, words.begin(), words.end()};
+
+    std::cout << std::endl;
+    std::cout << "Lookups                         Lookups/sec   Speedup" << std::endl;
+
+    double oneAtATime = perSecond(
+        views.size(),
+        [&]()
+        {
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                results[i] = set.contains(views[i]);
+            }
+        });
+
+    printRate("contains() each", oneAtATime, oneAtATime);
+
+    printRate(
+        "hashMany + containsMany()",
+        perSecond(
+            views.size(),
+            [&]()
+            {
+                hashMany(views.data(), views.size(), hashes.data());
+                set.containsMany(
+                    views.data(), hashes.data(), views.size(), results.get());
+            }),
+        oneAtATime);
+}
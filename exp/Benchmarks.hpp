@@ -0,0 +1,99 @@
+// Benchmarks.hpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// The benchmarks that can be run from the "exp" program.  Each one reads
+// whatever input it needs (e.g., the path to a word file) from the
+// standard input, one item per line, and writes its results to the
+// standard output.
+
+#ifndef BENCHMARKS_HPP
+#define BENCHMARKS_HPP
+
+
+
+// Measures the latency of every individual HashSet::add() while loading
+// a word set, with all-at-once and incremental resizing, and reports the
+// mean, 99th percentile, and maximum.  The same is then measured for
+// millions of distinct words made by suffixing copies of the word set.
+//
+// Input: the path to a word file
+void runAddLatencyBenchmark();
+
+
+// Runs 1, 2, 4, ... up to std::thread::hardware_concurrency() reader
+// threads calling ConcurrentHashSet::contains() while one writer thread
+// keeps adding words, and reports the readers' combined and per-thread
+// throughput.
+//
+// Input: the path to a word file
+void runConcurrentReadBenchmark();
+
+
+// Loads a word set into a StripedHashSet with 1, 2, 4, ... up to
+// std::thread::hardware_concurrency() threads, and reports how long each
+// load takes and its speedup over one thread.
+//
+// Input: the path to a word file, then the number of copies of it to
+// load (each copy's words made distinct by a numeric suffix)
+void runParallelLoadBenchmark();
+
+
+// Runs every hash function in StringHashing.hpp over the words in a word
+// file and the distinct words in a text file, and reports the time per
+// hash, the collisions at each capacity a HashSet passes through while
+// loading them (against the number a uniform hash would give), a
+// chi-squared test of the final bucket counts, and avalanche bias.  The
+// results are also written, one measurement per line, to a CSV file with
+// the columns input, function, metric, capacity, and value.
+//
+// Input: the path to a word file, then the path to a text file, then the
+// path of the CSV file to write
+void runHashQualityBenchmark();
+
+
+// Generates a list of words that all collide under hashStringAsProduct(),
+// as an adversary might, and compares the time to load them into a
+// HashSet, and the mean and worst latency of looking them (and colliding
+// words that aren't in the set) up, using the product hash, FastHash
+// unseeded and seeded with processHashSeed(), and SipHash.
+//
+// Input: the number of two-character blocks in each generated word (n
+// blocks generate 2^(n-1) words to load and as many to look up that are
+// missing)
+void runAdversarialHashBenchmark();
+
+
+// Generates the one-letter insertions and replacements of words in a
+// word file, as WordChecker would, and compares the rate at which they're
+// hashed (with ProductHash) one at a time against each of hashMany()'s
+// kernels, and the rate at which they're looked up in a HashSet with
+// contains() against hashMany() followed by containsMany().
+//
+// Input: the path to a word file
+void runBatchHashBenchmark();
+
+
+// Loads a word file into an AVLSet, an ArenaAVLSet, and a BTreeSet (built
+// with addSorted()) and reports the bytes each occupies (in total and per
+// word) and the rate at which each looks up every word, in a shuffled
+// order.
+//
+// Input: the path to a word file
+void runAVLMemoryBenchmark();
+
+
+// Measures a plain AVLSet on one thread (looking words up, then adding
+// them), then runs 1, 2, 4, ... up to std::thread::hardware_concurrency()
+// reader threads calling contains() on an AVLSet that allows concurrent
+// reads while one writer thread keeps adding words, and reports the
+// readers' combined and per-thread throughput against the plain set's.
+//
+// Input: the path to a word file
+void runConcurrentAVLBenchmark();
+
+
+
+#endif
+
@@ -0,0 +1,188 @@
+// ConcurrentAVLBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmarks.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    constexpr std::chrono::milliseconds RUN_TIME{500};
+
+
+    struct RunResult
+    {
+        unsigned long long lookups;
+        unsigned long long adds;
+    };
+
+
+    // The word the writer adds after it runs out of real ones.
+    std::string madeUpWord(std::size_t i)
+    {
+        return "NOTAWORD" + std::to_string(i);
+    }
+
+
+    // Each set starts with the first half of the words.
+    void addFirstHalf(AVLSet<std::string>& set, const std::vector<std::string>& words)
+    {
+        set.addSorted(words.begin(), words.begin() + words.size() / 2);
+    }
+
+
+    // A plain AVLSet, used by one thread: first only looking words up for
+    // RUN_TIME, then only adding them for RUN_TIME.
+    RunResult runSingleThreaded(const std::vector<std::string>& words)
+    {
+        AVLSet<std::string> set;
+        addFirstHalf(set, words);
+
+        RunResult result{0, 0};
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; std::chrono::steady_clock::now() - start < RUN_TIME; i = (i + 7919) % words.size())
+        {
+            set.contains(words[i]);
+            ++result.lookups;
+        }
+
+        start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = words.size() / 2; std::chrono::steady_clock::now() - start < RUN_TIME; ++i)
+        {
+            set.add(i < words.size() ? words[i] : madeUpWord(i));
+            ++result.adds;
+        }
+
+        return result;
+    }
+
+
+    // An AVLSet allowing concurrent reads, searched by the given number of
+    // reader threads while one writer adds the other half of the words,
+    // then keeps adding made-up words, for RUN_TIME.
+    RunResult runReadersAndWriter(
+        const std::vector<std::string>& words, unsigned int readerCount)
+    {
+        AVLSet<std::string> set;
+        addFirstHalf(set, words);
+        set.allowConcurrentReads();
+
+        std::atomic<bool> running{true};
+        std::atomic<unsigned long long> lookups{0};
+        unsigned long long adds = 0;
+
+        std::thread writer{
+            [&]()
+            {
+                for (std::size_t i = words.size() / 2; running.load(std::memory_order_relaxed); ++i)
+                {
+                    set.add(i < words.size() ? words[i] : madeUpWord(i));
+                    ++adds;
+                }
+            }};
+
+        std::vector<std::thread> readers;
+
+        for (unsigned int r = 0; r < readerCount; ++r)
+        {
+            readers.emplace_back(
+                [&, r]()
+                {
+                    unsigned long long done = 0;
+
+                    for (std::size_t i = r; running.load(std::memory_order_relaxed); i = (i + 7919) % words.size())
+                    {
+                        set.contains(words[i]);
+                        ++done;
+                    }
+
+                    lookups.fetch_add(done);
+                });
+        }
+
+        std::this_thread::sleep_for(RUN_TIME);
+        running.store(false);
+
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+
+        writer.join();
+
+        return RunResult{lookups.load(), adds};
+    }
+
+
+    void printRow(
+        const std::string& name, const RunResult& result, unsigned int readers,
+        double baselineLookups)
+    {
+        double seconds = std::chrono::duration<double>(RUN_TIME).count();
+        double lookups = result.lookups / seconds;
+
+        std::cout << std::left << std::setw(10) << name;
+        std::cout << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(15) << lookups
+                  << std::setw(15) << lookups / readers
+                  << std::setw(14) << result.adds / seconds
+                  << std::setprecision(2) << std::setw(10) << lookups / baselineLookups << std::endl;
+    }
+}
+
+
+
+void runConcurrentAVLBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+    unsigned int maxReaders = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Running a plain AVLSet on one thread, then 1 to " << maxReaders
+              << " reader threads against one writer, " << RUN_TIME.count() << "ms each ..."
+              << std::endl;
+
+    std::vector<unsigned int> readerCounts;
+
+    for (unsigned int readers = 1; readers < maxReaders; readers *= 2)
+    {
+        readerCounts.push_back(readers);
+    }
+
+    readerCounts.push_back(maxReaders);
+
+    RunResult single = runSingleThreaded(words);
+    double seconds = std::chrono::duration<double>(RUN_TIME).count();
+    double baselineLookups = single.lookups / seconds;
+
+    std::cout << std::endl;
+    std::cout << "RESULTS" << std::endl;
+    std::cout << "Readers       Lookups/sec     Per Reader      Adds/sec   Speedup" << std::endl;
+
+    printRow("plain", single, 1, baselineLookups);
+
+    for (unsigned int readers : readerCounts)
+    {
+        printRow(std::to_string(readers), runReadersAndWriter(words, readers), readers, baselineLookups);
+    }
+
+    std::cout << std::endl;
+    std::cout << "(The plain AVLSet's lookups and adds are measured separately, one after the other.)"
+              << std::endl;
+}
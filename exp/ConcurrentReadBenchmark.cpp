@@ -0,0 +1,127 @@
+// ConcurrentReadBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "ConcurrentHashSet.hpp"
+#include "StringHashing.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    constexpr std::chrono::milliseconds RUN_TIME{500};
+
+
+    struct RunResult
+    {
+        unsigned long long lookups;
+        unsigned long long adds;
+    };
+
+
+    RunResult runReadersAndWriter(
+        const std::vector<std::string>& words, unsigned int readerCount)
+    {
+        // The set starts with half the words; the writer adds the other
+        // half, then keeps adding made-up words, for as long as the
+        // readers run.
+        ConcurrentHashSet<std::string, ProductHash> set{ProductHash{}};
+        set.addAll(words.begin(), words.begin() + words.size() / 2);
+
+        std::atomic<bool> running{true};
+        std::atomic<unsigned long long> lookups{0};
+        unsigned long long adds = 0;
+
+        std::thread writer{
+            [&]()
+            {
+                for (std::size_t i = words.size() / 2; running.load(std::memory_order_relaxed); ++i)
+                {
+                    set.add(i < words.size() ? words[i] : "NOTAWORD" + std::to_string(i));
+                    ++adds;
+                }
+            }};
+
+        std::vector<std::thread> readers;
+
+        for (unsigned int r = 0; r < readerCount; ++r)
+        {
+            readers.emplace_back(
+                [&, r]()
+                {
+                    unsigned long long done = 0;
+
+                    for (std::size_t i = r; running.load(std::memory_order_relaxed); i = (i + 7919) % words.size())
+                    {
+                        set.contains(words[i]);
+                        ++done;
+                    }
+
+                    lookups.fetch_add(done);
+                });
+        }
+
+        std::this_thread::sleep_for(RUN_TIME);
+        running.store(false);
+
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+
+        writer.join();
+
+        return RunResult{lookups.load(), adds};
+    }
+}
+
+
+
+void runConcurrentReadBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+    unsigned int maxReaders = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Running 1 to " << maxReaders << " reader threads against one writer, "
+              << RUN_TIME.count() << "ms each ..." << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "RESULTS" << std::endl;
+    std::cout << "Readers      Lookups/sec     Per Reader      Adds/sec" << std::endl;
+
+    std::vector<unsigned int> readerCounts;
+
+    for (unsigned int readers = 1; readers < maxReaders; readers *= 2)
+    {
+        readerCounts.push_back(readers);
+    }
+
+    readerCounts.push_back(maxReaders);
+
+    for (unsigned int readers : readerCounts)
+    {
+        RunResult result = runReadersAndWriter(words, readers);
+        double seconds = std::chrono::duration<double>(RUN_TIME).count();
+
+        std::cout << std::left << std::setw(8) << readers;
+        std::cout << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(15) << result.lookups / seconds
+                  << std::setw(15) << result.lookups / seconds / readers
+                  << std::setw(14) << result.adds / seconds << std::endl;
+    }
+}
+
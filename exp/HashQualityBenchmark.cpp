@@ -0,0 +1,313 @@
+// HashQualityBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "StringHashing.hpp"
+#include "TextFileReader.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    struct HashFunction
+    {
+        std::string name;
+        unsigned int (*hash)(const std::string&);
+    };
+
+
+    const std::vector<HashFunction> HASH_FUNCTIONS{
+        {"ZERO", hashStringAsZero},
+        {"SUM", hashStringAsSum},
+        {"PRODUCT", hashStringAsProduct},
+        {"FNV1A", [](const std::string& word) { return Fnv1aHash{}(word); }},
+        {"FAST", hashStringAsFast},
+        {"SIP", [](const std::string& word) { static const SipHash sipHash; return sipHash(word); }}
+    };
+
+
+    // Keys are hashed this many times over when timing, so that even the
+    // small inputs take long enough to measure.
+    constexpr unsigned int TIMING_ROUNDS = 20;
+
+    // Avalanche is measured on at most this many keys, since every bit of
+    // every one of them is flipped in turn.
+    constexpr std::size_t AVALANCHE_KEYS = 2000;
+
+
+    struct Quality
+    {
+        double nanosecondsPerHash;
+
+        // One entry per capacity in HashSet's growth sequence, up to the
+        // one it would reach holding every key.
+        std::vector<unsigned int> capacities;
+        std::vector<unsigned int> keysAtCapacity;
+        std::vector<unsigned int> collisions;
+        std::vector<double> expectedCollisions;
+
+        // The chi-squared statistic of the bucket counts at the final
+        // capacity, divided by its degrees of freedom, so that it's near
+        // 1 for a uniform hash whatever the capacity.
+        double chiSquaredRatio;
+
+        // The probability that flipping one input bit flips a given output
+        // bit should be 0.5; the bias is twice its distance from 0.5,
+        // averaged over (and at worst among) every pair of input bit and
+        // output bit.
+        double meanAvalancheBias;
+        double worstAvalancheBias;
+    };
+
+
+    std::vector<std::string> distinctWordsFromText(const std::string& textFilePath)
+    {
+        std::vector<std::string> words;
+
+        for (TextFileReader reader{textFilePath}; !reader.noMoreWords(); reader.advanceToNextWord())
+        {
+            words.push_back(reader.currentWord());
+        }
+
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+
+
+    double timeHashing(const HashFunction& function, const std::vector<std::string>& keys)
+    {
+        unsigned int sink = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (unsigned int round = 0; round < TIMING_ROUNDS; ++round)
+        {
+            for (const std::string& key : keys)
+            {
+                sink += function.hash(key);
+            }
+        }
+
+        auto stop = std::chrono::steady_clock::now();
+
+        // Keeps the compiler from discarding the calls.
+        volatile unsigned int result = sink;
+        static_cast<void>(result);
+
+        return std::chrono::duration<double, std::nano>(stop - start).count()
+               / (static_cast<double>(TIMING_ROUNDS) * std::max<std::size_t>(1, keys.size()));
+    }
+
+
+    void measureCollisions(
+        const std::vector<unsigned int>& hashes, Quality& quality)
+    {
+        // A HashSet of capacity c holds at most 0.8c elements before
+        // growing, so that's how many keys are placed at each capacity.
+        for (unsigned int capacity = 10; ; capacity = capacity * 2 + 1)
+        {
+            unsigned int keys = std::min(
+                static_cast<unsigned int>(hashes.size()), capacity * 4 / 5);
+
+            std::vector<unsigned int> buckets(capacity, 0);
+            unsigned int collisions = 0;
+
+            for (unsigned int i = 0; i < keys; ++i)
+            {
+                if (buckets[hashes[i] % capacity]++ > 0)
+                {
+                    ++collisions;
+                }
+            }
+
+            // Placing k keys uniformly into c buckets leaves
+            // c(1 - 1/c)^k of them empty, and every key that didn't land
+            // in an empty bucket collided.
+            double expectedEmpty = capacity * std::pow(1.0 - 1.0 / capacity, keys);
+
+            quality.capacities.push_back(capacity);
+            quality.keysAtCapacity.push_back(keys);
+            quality.collisions.push_back(collisions);
+            quality.expectedCollisions.push_back(keys - (capacity - expectedEmpty));
+
+            if (keys == hashes.size())
+            {
+                double expected = static_cast<double>(keys) / capacity;
+                double chiSquared = 0.0;
+
+                for (unsigned int count : buckets)
+                {
+                    chiSquared += (count - expected) * (count - expected) / expected;
+                }
+
+                quality.chiSquaredRatio = chiSquared / (capacity - 1);
+                return;
+            }
+        }
+    }
+
+
+    void measureAvalanche(
+        const HashFunction& function, const std::vector<std::string>& keys, Quality& quality)
+    {
+        std::size_t keyCount = std::min(keys.size(), AVALANCHE_KEYS);
+        double totalBias = 0.0;
+        unsigned long long pairs = 0;
+        quality.worstAvalancheBias = 0.0;
+
+        // Flipping the same bit position means different things in keys
+        // of different lengths, so flips are tallied per input byte
+        // position and bit, across the keys long enough to have it.
+        for (std::size_t byte = 0; ; ++byte)
+        {
+            std::vector<unsigned int> flips(8 * 32, 0);
+            unsigned int trials = 0;
+
+            for (std::size_t k = 0; k < keyCount; ++k)
+            {
+                if (keys[k].size() <= byte)
+                {
+                    continue;
+                }
+
+                std::string key = keys[k];
+                unsigned int original = function.hash(key);
+
+                for (unsigned int bit = 0; bit < 8; ++bit)
+                {
+                    key[byte] ^= static_cast<char>(1 << bit);
+                    unsigned int changed = original ^ function.hash(key);
+                    key[byte] ^= static_cast<char>(1 << bit);
+
+                    for (unsigned int out = 0; out < 32; ++out)
+                    {
+                        flips[bit * 32 + out] += (changed >> out) & 1;
+                    }
+                }
+
+                ++trials;
+            }
+
+            // Positions that only a handful of keys reach say little.
+            if (trials < 100)
+            {
+                break;
+            }
+
+            for (unsigned int f : flips)
+            {
+                double bias = std::fabs(2.0 * f / trials - 1.0);
+                totalBias += bias;
+                quality.worstAvalancheBias = std::max(quality.worstAvalancheBias, bias);
+                ++pairs;
+            }
+        }
+
+        quality.meanAvalancheBias = pairs == 0 ? 0.0 : totalBias / pairs;
+    }
+
+
+    Quality measureQuality(const HashFunction& function, const std::vector<std::string>& keys)
+    {
+        Quality quality{};
+        quality.nanosecondsPerHash = timeHashing(function, keys);
+
+        std::vector<unsigned int> hashes;
+        hashes.reserve(keys.size());
+
+        for (const std::string& key : keys)
+        {
+            hashes.push_back(function.hash(key));
+        }
+
+        measureCollisions(hashes, quality);
+        measureAvalanche(function, keys, quality);
+
+        return quality;
+    }
+
+
+    void report(
+        const std::string& inputName, const std::vector<std::string>& keys,
+        std::ofstream& output)
+    {
+        std::cout << std::endl;
+        std::cout << inputName << " (" << keys.size() << " distinct keys)" << std::endl;
+        std::cout << "Function     ns/hash   Collisions   Expected   ChiSq/df   AvgBias  WorstBias" << std::endl;
+
+        for (const HashFunction& function : HASH_FUNCTIONS)
+        {
+            Quality quality = measureQuality(function, keys);
+
+            std::cout << std::left << std::setw(10) << function.name;
+            std::cout << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(10) << quality.nanosecondsPerHash
+                      << std::setw(13) << quality.collisions.back()
+                      << std::setprecision(0) << std::setw(11) << quality.expectedCollisions.back()
+                      << std::setprecision(2) << std::setw(11) << quality.chiSquaredRatio
+                      << std::setprecision(3) << std::setw(10) << quality.meanAvalancheBias
+                      << std::setw(11) << quality.worstAvalancheBias << std::endl;
+
+            std::string prefix = inputName + "," + function.name + ",";
+
+            output << prefix << "ns_per_hash,," << quality.nanosecondsPerHash << "\n";
+            output << prefix << "chi_squared_ratio,," << quality.chiSquaredRatio << "\n";
+            output << prefix << "mean_avalanche_bias,," << quality.meanAvalancheBias << "\n";
+            output << prefix << "worst_avalanche_bias,," << quality.worstAvalancheBias << "\n";
+
+            for (std::size_t i = 0; i < quality.capacities.size(); ++i)
+            {
+                std::string capacity = std::to_string(quality.capacities[i]);
+
+                output << prefix << "keys," << capacity << "," << quality.keysAtCapacity[i] << "\n";
+                output << prefix << "collisions," << capacity << "," << quality.collisions[i] << "\n";
+                output << prefix << "expected_collisions," << capacity << ","
+                       << quality.expectedCollisions[i] << "\n";
+            }
+        }
+    }
+}
+
+
+
+void runHashQualityBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::string textFilePath;
+    std::getline(std::cin, textFilePath);
+
+    std::string outputFilePath;
+    std::getline(std::cin, outputFilePath);
+
+    std::ofstream output{outputFilePath};
+
+    if (!output)
+    {
+        std::cout << "ERROR: Cannot write to " << outputFilePath << std::endl;
+        return;
+    }
+
+    output << "input,function,metric,capacity,value\n";
+    output << std::setprecision(6);
+
+    std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+    report(wordFilePath, words, output);
+    report(textFilePath, distinctWordsFromText(textFilePath), output);
+
+    std::cout << std::endl;
+    std::cout << "Wrote results to " << outputFilePath << std::endl;
+}
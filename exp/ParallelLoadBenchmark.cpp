@@ -0,0 +1,103 @@
+// ParallelLoadBenchmark.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmarks.hpp"
+#include "StringHashing.hpp"
+#include "StripedHashSet.hpp"
+#include "WordSetLoader.hpp"
+
+
+
+namespace
+{
+    double secondsToLoad(const std::vector<std::string>& words, unsigned int threadCount)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        StripedHashSet<std::string, ProductHash> set{ProductHash{}};
+        set.addAllParallel(words.begin(), words.end(), threadCount);
+
+        auto end = std::chrono::steady_clock::now();
+
+        if (set.size() != words.size())
+        {
+            std::cout << "ERROR: Loaded " << set.size() << " of " << words.size() << " words" << std::endl;
+        }
+
+        return std::chrono::duration<double>(end - start).count();
+    }
+}
+
+
+
+void runParallelLoadBenchmark()
+{
+    std::string wordFilePath;
+    std::getline(std::cin, wordFilePath);
+
+    std::string copiesLine;
+    std::getline(std::cin, copiesLine);
+
+    unsigned int copies = std::max(1, std::atoi(copiesLine.c_str()));
+
+    // Merging several dictionaries is simulated by suffixing every word
+    // with the number of the copy it came from, so all of them are
+    // distinct.
+    std::vector<std::string> loaded = WordSetLoader{}.load(wordFilePath);
+    std::vector<std::string> words;
+    words.reserve(loaded.size() * copies);
+
+    for (unsigned int c = 0; c < copies; ++c)
+    {
+        for (const std::string& word : loaded)
+        {
+            words.push_back(c == 0 ? word : word + std::to_string(c));
+        }
+    }
+
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Loading " << words.size() << " words into a StripedHashSet with 1 to "
+              << maxThreads << " threads ..." << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "RESULTS" << std::endl;
+    std::cout << "Threads     Seconds     Words/sec     Speedup" << std::endl;
+
+    std::vector<unsigned int> threadCounts;
+
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+
+    threadCounts.push_back(maxThreads);
+
+    double baseline = 0.0;
+
+    for (unsigned int threads : threadCounts)
+    {
+        double seconds = secondsToLoad(words, threads);
+
+        if (threads == 1)
+        {
+            baseline = seconds;
+        }
+
+        std::cout << std::left << std::setw(8) << threads;
+        std::cout << std::right << std::fixed
+                  << std::setprecision(4) << std::setw(11) << seconds
+                  << std::setprecision(0) << std::setw(14) << words.size() / seconds
+                  << std::setprecision(2) << std::setw(11) << baseline / seconds << std::endl;
+    }
+}
@@ -6,11 +6,56 @@
 // Do whatever you'd like here.  This is intended to allow you to experiment
 // with your code, outside of the context of the broader program or Google
 // Test.
+//
+// The first line of the standard input names the benchmark to run (see
+// Benchmarks.hpp); the benchmark reads the rest of its input itself.
+
+#include <iostream>
+#include <string>
+#include "Benchmarks.hpp"
 
 
 int main()
 {
+    std::string benchmark;
+    std::getline(std::cin, benchmark);
 
+    if (benchmark == "ADD LATENCY")
+    {
+        runAddLatencyBenchmark();
+    }
+    else if (benchmark == "CONCURRENT READ")
+    {
+        runConcurrentReadBenchmark();
+    }
+    else if (benchmark == "PARALLEL LOAD")
+    {
+        runParallelLoadBenchmark();
+    }
+    else if (benchmark == "HASH QUALITY")
+    {
+        runHashQualityBenchmark();
+    }
+    else if (benchmark == "ADVERSARIAL HASH")
+    {
+        runAdversarialHashBenchmark();
+    }
+    else if (benchmark == "BATCH HASH")
+    {
+        runBatchHashBenchmark();
+    }
+    else if (benchmark == "AVL MEMORY")
+    {
+        runAVLMemoryBenchmark();
+    }
+    else if (benchmark == "AVL CONCURRENT")
+    {
+        runConcurrentAVLBenchmark();
+    }
+    else
+    {
+        std::cout << "ERROR: Unknown benchmark: " << benchmark << std::endl;
+    }
 
     return 0;
 }
@@ -0,0 +1,564 @@
+// AVLSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for AVLSet, beyond the provided sanity checks.
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "FrozenAVLSet.hpp"
+
+
+TEST(AVLSet_Tests, addingDuplicatesLeavesTheTreeAlone)
+{
+    AVLSet<std::string> s;
+
+    for (const char* word : {"MANGO", "APPLE", "PEAR", "APPLE", "MANGO", "KIWI"})
+    {
+        s.add(word);
+    }
+
+    std::vector<std::string> elements;
+    s.preorder([&](const std::string& element) { elements.push_back(element); });
+
+    EXPECT_EQ(4, s.size());
+    EXPECT_EQ(2, s.height());
+    EXPECT_EQ((std::vector<std::string>{"MANGO", "APPLE", "KIWI", "PEAR"}), elements);
+}
+
+
+TEST(AVLSet_Tests, rebalancesOnTheWayBackUp)
+{
+    AVLSet<int> s;
+
+    // Each of these triggers one of the four rotations.
+    for (int i : {30, 20, 10, 40, 50, 25, 22, 45, 47})
+    {
+        s.add(i);
+    }
+
+    std::vector<int> elements;
+    s.preorder([&](int element) { elements.push_back(element); });
+
+    EXPECT_EQ(3, s.height());
+    EXPECT_EQ((std::vector<int>{30, 20, 10, 25, 22, 45, 40, 50, 47}), elements);
+}
+
+
+TEST(AVLSet_Tests, unbalancedTreesDeeperThanThePathStackKeepTheirHeights)
+{
+    AVLSet<int> s{false};
+
+    for (int i = 0; i < 200; ++i)
+    {
+        s.add(i);
+        ASSERT_EQ(i, s.height());
+    }
+
+    s.add(-1);
+    EXPECT_EQ(199, s.height());
+    EXPECT_EQ(201, s.size());
+    EXPECT_TRUE(s.contains(150));
+    EXPECT_TRUE(s.contains(-1));
+}
+
+
+TEST(AVLSet_Tests, addSortedBuildsAPerfectlyBalancedTree)
+{
+    std::vector<int> elements;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        elements.push_back(i);
+    }
+
+    AVLSet<int> s;
+    s.addSorted(elements.begin(), elements.end());
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_EQ(9, s.height());
+
+    std::vector<int> visited;
+    s.inorder([&](int element) { visited.push_back(element); });
+    EXPECT_EQ(elements, visited);
+
+    // The heights must be right for later adds to rebalance correctly.
+    for (int i = 1000; i < 2000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(2000, s.size());
+    EXPECT_LE(s.height(), 12);
+}
+
+
+TEST(AVLSet_Tests, addSortedMergesWithExistingElements)
+{
+    AVLSet<std::string> s;
+    s.add("DOG");
+    s.add("ANT");
+    s.add("MOOSE");
+
+    std::vector<std::string> words{"BEE", "CAT", "CAT", "DOG", "ZEBRA"};
+    s.addSorted(words.begin(), words.end());
+
+    std::vector<std::string> visited;
+    s.inorder([&](const std::string& element) { visited.push_back(element); });
+
+    EXPECT_EQ(6, s.size());
+    EXPECT_EQ(2, s.height());
+    EXPECT_EQ((std::vector<std::string>{"ANT", "BEE", "CAT", "DOG", "MOOSE", "ZEBRA"}), visited);
+}
+
+
+TEST(AVLSet_Tests, addSortedSortsUnsortedInput)
+{
+    std::vector<int> elements{5, 3, 9, 1, 3, 7};
+
+    AVLSet<int> s;
+    s.add(4);
+    s.addSorted(elements.begin(), elements.end());
+
+    std::vector<int> visited;
+    s.inorder([&](int element) { visited.push_back(element); });
+
+    EXPECT_EQ(6, s.size());
+    EXPECT_EQ((std::vector<int>{1, 3, 4, 5, 7, 9}), visited);
+}
+
+
+TEST(AVLSet_Tests, frozenSetsFindExactlyWhatTheTreeFinds)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i * 2);
+    }
+
+    s.freeze();
+    ASSERT_TRUE(s.isFrozen());
+
+    for (int i = -3; i < 2003; ++i)
+    {
+        EXPECT_EQ(i >= 0 && i < 2000 && i % 2 == 0, s.contains(i)) << i;
+    }
+
+    s.add(7);
+    EXPECT_FALSE(s.isFrozen());
+    EXPECT_TRUE(s.contains(7));
+}
+
+
+TEST(AVLSet_Tests, frozenStringSetsFindViews)
+{
+    FrozenAVLSet<std::string> s;
+    std::vector<std::string> words{"BEE", "CAT", "DOG", "EEL", "FOX", "GNU", "YAK"};
+    s.addAll(words.begin(), words.end());
+
+    ASSERT_TRUE(s.isFrozen());
+
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(s.contains(word));
+        EXPECT_TRUE(s.contains(std::string_view{word}));
+    }
+
+    for (const char* word : {"", "ANT", "CATS", "DO", "ZEBRA"})
+    {
+        EXPECT_FALSE(s.contains(std::string_view{word}));
+    }
+
+    s.add("DOG");
+    EXPECT_TRUE(s.isFrozen());
+
+    AVLSet<std::string> empty;
+    empty.freeze();
+    EXPECT_FALSE(empty.contains(std::string{"CAT"}));
+}
+
+
+TEST(AVLSet_Tests, frozenStringSetsCompareBeyondTheCachedPrefix)
+{
+    AVLSet<std::string> s;
+    std::vector<std::string> words{
+        "SPELL", "SPELLING", "SPELLINGS", "SPELLINGZ", std::string{"SPELL\xe9"}, std::string{"SPE\0LL", 6}};
+
+    for (const std::string& word : words)
+    {
+        s.add(word);
+    }
+
+    s.freeze();
+
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(s.contains(std::string_view{word}));
+    }
+
+    for (const char* word : {"SPEL", "SPELLINGA", "SPELLINGSS", "SPELLINGT", "SPE"})
+    {
+        EXPECT_FALSE(s.contains(std::string_view{word}));
+    }
+}
+
+
+TEST(AVLSet_Tests, copiesAreSnapshotsThatAddingDoesNotDisturb)
+{
+    AVLSet<int> original;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        original.add(i * 2);
+    }
+
+    AVLSet<int> snapshot{original};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        original.add(i * 2 + 1);
+    }
+
+    AVLSet<int> later{original};
+    later.add(1000);
+
+    EXPECT_EQ(100, snapshot.size());
+    EXPECT_EQ(200, original.size());
+    EXPECT_EQ(201, later.size());
+
+    for (int i = 0; i < 200; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, snapshot.contains(i)) << i;
+        EXPECT_TRUE(original.contains(i));
+    }
+
+    EXPECT_FALSE(original.contains(1000));
+
+    std::vector<int> elements;
+    snapshot.inorder([&](int element) { elements.push_back(element); });
+    ASSERT_EQ(100, elements.size());
+    EXPECT_EQ(6, snapshot.height());
+
+    // Assigning and rebuilding in bulk also leave the other copies alone.
+    snapshot = later;
+    std::vector<int> more{-3, -2, -1};
+    snapshot.addSorted(more.begin(), more.end());
+
+    EXPECT_EQ(204, snapshot.size());
+    EXPECT_EQ(201, later.size());
+    EXPECT_FALSE(later.contains(-1));
+
+    AVLSet<int> moved{std::move(later)};
+    EXPECT_EQ(201, moved.size());
+    EXPECT_EQ(0, later.size());
+    EXPECT_FALSE(later.contains(0));
+}
+
+
+TEST(AVLSet_Tests, snapshotsCanBeSearchedWhileTheOriginalGrows)
+{
+    AVLSet<int> original;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        original.add(i);
+    }
+
+    AVLSet<int> snapshot{original};
+    std::atomic<bool> allFound{true};
+
+    std::thread reader{
+        [&]()
+        {
+            for (int round = 0; round < 50; ++round)
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    if (!snapshot.contains(i) || snapshot.contains(i + 1000))
+                    {
+                        allFound = false;
+                    }
+                }
+            }
+        }};
+
+    for (int i = 1000; i < 20000; ++i)
+    {
+        original.add(i);
+    }
+
+    reader.join();
+
+    EXPECT_TRUE(allFound);
+    EXPECT_EQ(1000, snapshot.size());
+    EXPECT_EQ(20000, original.size());
+}
+
+
+TEST(AVLSet_Tests, concurrentReadersFindEverythingAddedBeforeThem)
+{
+    AVLSet<int> s;
+    s.allowConcurrentReads();
+
+    constexpr int COUNT = 20000;
+    std::atomic<int> added{0};
+    std::atomic<bool> allFound{true};
+
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back(
+            [&, r]()
+            {
+                for (unsigned int step = r; added.load(std::memory_order_acquire) < COUNT; step += 7919)
+                {
+                    int limit = added.load(std::memory_order_acquire);
+
+                    if (limit > 0 && !s.contains(static_cast<int>(step % limit)))
+                    {
+                        allFound = false;
+                    }
+
+                    if (s.contains(-1 - static_cast<int>(step % COUNT)))
+                    {
+                        allFound = false;
+                    }
+                }
+            });
+    }
+
+    // Adding in ascending order rotates at nearly every step.
+    for (int i = 0; i < COUNT; ++i)
+    {
+        s.add(i);
+        added.store(i + 1, std::memory_order_release);
+    }
+
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_TRUE(allFound);
+    EXPECT_EQ(COUNT, s.size());
+    EXPECT_EQ(14, s.height());
+}
+
+
+TEST(AVLSet_Tests, concurrentWritersTakeTurns)
+{
+    AVLSet<int> s;
+    s.allowConcurrentReads();
+
+    std::thread evens{
+        [&]()
+        {
+            for (int i = 0; i < 10000; i += 2)
+            {
+                s.add(i);
+            }
+        }};
+
+    for (int i = 1; i < 10000; i += 2)
+    {
+        s.add(i);
+    }
+
+    evens.join();
+
+    EXPECT_EQ(10000, s.size());
+
+    std::vector<int> elements;
+    s.inorder([&](int element) { elements.push_back(element); });
+
+    ASSERT_EQ(10000, elements.size());
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_EQ(i, elements[i]);
+    }
+}
+
+
+TEST(AVLSet_Tests, concurrentSetsNeitherFreezeNorRebuild)
+{
+    std::vector<int> first{1, 2, 3};
+
+    AVLSet<int> s;
+    s.addSorted(first.begin(), first.end());
+    s.freeze();
+    s.allowConcurrentReads();
+
+    EXPECT_TRUE(s.allowsConcurrentReads());
+    EXPECT_FALSE(s.isFrozen());
+
+    std::vector<int> more;
+
+    for (int i = 4; i <= 100; ++i)
+    {
+        more.push_back(i);
+    }
+
+    s.addSorted(more.begin(), more.end());
+    s.freeze();
+
+    EXPECT_FALSE(s.isFrozen());
+    EXPECT_EQ(100, s.size());
+
+    for (int i = 1; i <= 100; ++i)
+    {
+        ASSERT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(AVLSet_Tests, iteratorsVisitElementsInOrderBothWays)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        s.add((i * 37) % 500);
+    }
+
+    int expected = 0;
+
+    for (int element : s)
+    {
+        EXPECT_EQ(expected, element);
+        ++expected;
+    }
+
+    EXPECT_EQ(500, expected);
+
+    auto i = s.end();
+
+    for (int element = 499; element >= 0; --element)
+    {
+        --i;
+        EXPECT_EQ(element, *i);
+    }
+
+    EXPECT_EQ(s.begin(), i);
+    EXPECT_EQ(s.end(), --i);
+
+    AVLSet<int> empty;
+    EXPECT_EQ(empty.end(), empty.begin());
+}
+
+
+TEST(AVLSet_Tests, boundsFindTheNeighborsOfMissingElements)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i * 10);
+    }
+
+    EXPECT_EQ(50, *s.lower_bound(50));
+    EXPECT_EQ(60, *s.upper_bound(50));
+    EXPECT_EQ(60, *s.lower_bound(51));
+    EXPECT_EQ(60, *s.upper_bound(51));
+    EXPECT_EQ(0, *s.lower_bound(-5));
+    EXPECT_EQ(s.end(), s.lower_bound(991));
+    EXPECT_EQ(s.end(), s.upper_bound(990));
+    EXPECT_EQ(40, *--s.lower_bound(45));
+}
+
+
+TEST(AVLSet_Tests, prefixRangesHoldExactlyTheMatchingWords)
+{
+    AVLSet<std::string> s;
+
+    for (const char* word : {"PRAY", "PRE", "PREACH", "PREFIX", "PRESS", "PRESTO", "PRIZE", "APE", "ZOO"})
+    {
+        s.add(word);
+    }
+
+    std::vector<std::string> found;
+
+    for (const std::string& word : s.prefixRange("PRE"))
+    {
+        found.push_back(word);
+    }
+
+    EXPECT_EQ((std::vector<std::string>{"PRE", "PREACH", "PREFIX", "PRESS", "PRESTO"}), found);
+
+    auto presses = s.prefixRange("PRES");
+    EXPECT_EQ(2, std::distance(presses.begin(), presses.end()));
+
+    auto none = s.prefixRange("PRO");
+    EXPECT_EQ(none.begin(), none.end());
+
+    auto all = s.prefixRange("");
+    EXPECT_EQ(9, std::distance(all.begin(), all.end()));
+
+    EXPECT_EQ("PREACH", *s.lower_bound(std::string_view{"PREA"}));
+}
+
+
+TEST(AVLSet_Tests, iteratorsWorkPastTheEndOfTheirPathStacks)
+{
+    AVLSet<int> s{false};
+
+    for (int i = 0; i < 150; ++i)
+    {
+        s.add(i);
+    }
+
+    int expected = 0;
+
+    for (int element : s)
+    {
+        ASSERT_EQ(expected, element);
+        ++expected;
+    }
+
+    EXPECT_EQ(150, expected);
+
+    auto i = s.end();
+
+    for (int element = 149; element >= 0; --element)
+    {
+        --i;
+        ASSERT_EQ(element, *i);
+    }
+}
+
+
+TEST(AVLSet_Tests, wordsSharingTheirFirstEightCharactersAreDistinguished)
+{
+    AVLSet<std::string> s;
+    std::vector<std::string> words{
+        "abcdefgh", "abcdefghi", "abcdefgha", "abcdefg", "abcdefgh\xe9",
+        "\xe9tude", "etude", "abcdefgz", "abcdefghij"};
+
+    for (const std::string& word : words)
+    {
+        s.add(word);
+    }
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(s.contains(word));
+        ASSERT_TRUE(s.contains(std::string_view{word}));
+    }
+
+    EXPECT_FALSE(s.contains(std::string{"abcdefghh"}));
+    EXPECT_FALSE(s.contains(std::string_view{"abcdef"}));
+    EXPECT_FALSE(s.contains(std::string{"\xe9tud"}));
+
+    std::vector<std::string> sorted = words;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::equal(s.begin(), s.end(), sorted.begin(), sorted.end()));
+}
@@ -0,0 +1,132 @@
+// ArenaAVLSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for ArenaAVLSet, checked against the shape AVLSet builds.
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "ArenaAVLSet.hpp"
+
+
+TEST(ArenaAVLSet_Tests, containsElementsAfterAdding)
+{
+    ArenaAVLSet<std::string> s;
+    s.add("CAT");
+    s.add("DOG");
+    s.add("CAT");
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(std::string{"CAT"}));
+    EXPECT_TRUE(s.contains(std::string{"DOG"}));
+    EXPECT_FALSE(s.contains(std::string{"COW"}));
+
+    std::string buffer = "HOTDOG";
+    EXPECT_TRUE(s.contains(std::string_view{buffer}.substr(3)));
+    EXPECT_FALSE(s.contains(std::string_view{buffer}));
+}
+
+
+TEST(ArenaAVLSet_Tests, buildsTheSameTreeAsAVLSet)
+{
+    AVLSet<int> pointers;
+    ArenaAVLSet<int> arena;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        int element = (i * 7919) % 1000;
+        pointers.add(element);
+        arena.add(element);
+    }
+
+    std::vector<int> expected;
+    std::vector<int> actual;
+    pointers.preorder([&](int element) { expected.push_back(element); });
+    arena.preorder([&](int element) { actual.push_back(element); });
+
+    EXPECT_EQ(pointers.height(), arena.height());
+    EXPECT_EQ(expected, actual);
+}
+
+
+TEST(ArenaAVLSet_Tests, staysBalancedWhenElementsAreAddedInOrder)
+{
+    ArenaAVLSet<int> balanced;
+    ArenaAVLSet<int> unbalanced{false};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        balanced.add(i);
+        unbalanced.add(i);
+    }
+
+    EXPECT_EQ(6, balanced.height());
+    EXPECT_EQ(99, unbalanced.height());
+
+    std::vector<int> elements;
+    balanced.inorder([&](int element) { elements.push_back(element); });
+
+    ASSERT_EQ(100, elements.size());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(i, elements[i]);
+    }
+}
+
+
+TEST(ArenaAVLSet_Tests, unbalancedTreesTallerThanAByteKeepTheirHeight)
+{
+    AVLSet<int> pointers{false};
+    ArenaAVLSet<int> arena{false};
+
+    for (int i = 0; i < 300; ++i)
+    {
+        pointers.add(i * 2);
+        arena.add(i * 2);
+    }
+
+    EXPECT_EQ(299, pointers.height());
+    EXPECT_EQ(299, arena.height());
+
+    // These are added deeper than add()'s stack, one partway down the
+    // chain and one at the bottom of it.
+    arena.add(301);
+    EXPECT_EQ(299, arena.height());
+    arena.add(599);
+    EXPECT_EQ(300, arena.height());
+    EXPECT_EQ(302, arena.size());
+
+    std::vector<int> elements;
+    arena.inorder([&](int element) { elements.push_back(element); });
+
+    ASSERT_EQ(302, elements.size());
+    EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end()));
+    EXPECT_TRUE(arena.contains(301));
+    EXPECT_TRUE(arena.contains(599));
+    EXPECT_FALSE(arena.contains(303));
+}
+
+
+TEST(ArenaAVLSet_Tests, copiesAreIndependent)
+{
+    ArenaAVLSet<std::string> s;
+    s.add("ALPHA");
+    s.add("BETA");
+
+    ArenaAVLSet<std::string> copy{s};
+    copy.add("GAMMA");
+
+    EXPECT_FALSE(s.contains(std::string{"GAMMA"}));
+    EXPECT_TRUE(copy.contains(std::string{"GAMMA"}));
+    EXPECT_TRUE(copy.contains(std::string{"ALPHA"}));
+
+    ArenaAVLSet<std::string> moved{std::move(copy)};
+    EXPECT_EQ(3, moved.size());
+    EXPECT_EQ(-1, copy.height());
+}
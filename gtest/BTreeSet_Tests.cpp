@@ -0,0 +1,189 @@
+// BTreeSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for BTreeSet, built both one element at a time and in bulk.
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BTreeSet.hpp"
+
+
+TEST(BTreeSet_Tests, containsElementsAfterAdding)
+{
+    BTreeSet<std::string> s;
+    s.add("CAT");
+    s.add("DOG");
+    s.add("CAT");
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(std::string{"CAT"}));
+    EXPECT_TRUE(s.contains(std::string{"DOG"}));
+    EXPECT_FALSE(s.contains(std::string{"COW"}));
+
+    std::string buffer = "HOTDOG";
+    EXPECT_TRUE(s.contains(std::string_view{buffer}.substr(3)));
+    EXPECT_FALSE(s.contains(std::string_view{buffer}));
+}
+
+
+TEST(BTreeSet_Tests, splitsNodesAsElementsAreAdded)
+{
+    BTreeSet<int> s;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add((i * 7919) % 1000);
+    }
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_LE(s.height(), 5);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(s.contains(i));
+    }
+
+    EXPECT_FALSE(s.contains(-1));
+    EXPECT_FALSE(s.contains(1000));
+
+    std::vector<int> elements;
+    s.inorder([&](int element) { elements.push_back(element); });
+
+    ASSERT_EQ(1000, elements.size());
+    EXPECT_TRUE(std::is_sorted(elements.begin(), elements.end()));
+}
+
+
+TEST(BTreeSet_Tests, bulkLoadsTreesOfEverySize)
+{
+    for (int count = 0; count <= 600; ++count)
+    {
+        std::vector<int> sorted;
+
+        for (int i = 0; i < count; ++i)
+        {
+            sorted.push_back(i * 2);
+        }
+
+        BTreeSet<int> s;
+        s.addSorted(sorted.begin(), sorted.end());
+
+        ASSERT_EQ(count, s.size());
+
+        std::vector<int> elements;
+        s.inorder([&](int element) { elements.push_back(element); });
+        ASSERT_EQ(sorted, elements);
+
+        for (int i = 0; i < count; ++i)
+        {
+            ASSERT_TRUE(s.contains(i * 2));
+            ASSERT_FALSE(s.contains(i * 2 + 1));
+        }
+
+        // Adding more afterward splits the bulk-loaded nodes as usual.
+        s.add(-1);
+        s.add(count * 2 + 1);
+        ASSERT_TRUE(s.contains(-1));
+        ASSERT_TRUE(s.contains(count * 2 + 1));
+        ASSERT_EQ(count + 2, s.size());
+    }
+}
+
+
+TEST(BTreeSet_Tests, bulkLoadingIsAsShallowAsPossible)
+{
+    std::vector<int> sorted;
+
+    for (int i = 0; i < 4096; ++i)
+    {
+        sorted.push_back(i);
+    }
+
+    BTreeSet<int> full;
+    full.addSorted(sorted.begin(), sorted.begin() + 4095);
+    EXPECT_EQ(3, full.height());
+
+    BTreeSet<int> overfull;
+    overfull.addSorted(sorted.begin(), sorted.end());
+    EXPECT_EQ(4, overfull.height());
+}
+
+
+TEST(BTreeSet_Tests, bulkLoadingSkipsDuplicatesAndSortsUnsortedInput)
+{
+    std::vector<std::string> words{"PEAR", "APPLE", "FIG", "APPLE", "KIWI", "FIG"};
+
+    BTreeSet<std::string> s;
+    s.addSorted(words.begin(), words.end());
+
+    std::vector<std::string> elements;
+    s.inorder([&](const std::string& element) { elements.push_back(element); });
+
+    EXPECT_EQ((std::vector<std::string>{"APPLE", "FIG", "KIWI", "PEAR"}), elements);
+}
+
+
+TEST(BTreeSet_Tests, wordsSharingTheirFirstEightCharactersAreDistinguished)
+{
+    std::vector<std::string> words{
+        "abcdefgh", "abcdefghi", "abcdefgha", "abcdefg", "abcdefgh\xe9",
+        "\xe9tude", "etude", "abcdefgz", "abcdefghij", "\xff\xff\xff\xff\xff\xff\xff\xff\xff"};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        words.push_back("internationalization" + std::to_string(i * 37 % 100));
+    }
+
+    for (int round = 0; round < 3; ++round)
+    {
+        BTreeSet<std::string> s;
+
+        if (round == 0)
+        {
+            s.addSorted(words.begin(), words.end());
+        }
+        else
+        {
+            for (const std::string& word : words)
+            {
+                s.add(word);
+            }
+        }
+
+        for (const std::string& word : words)
+        {
+            ASSERT_TRUE(s.contains(word));
+            ASSERT_TRUE(s.contains(std::string_view{word}));
+        }
+
+        EXPECT_FALSE(s.contains(std::string{"abcdefghh"}));
+        EXPECT_FALSE(s.contains(std::string_view{"internationalization"}));
+        EXPECT_FALSE(s.contains(std::string{"\xff\xff\xff\xff\xff\xff\xff\xff"}));
+
+        std::reverse(words.begin(), words.end());
+    }
+}
+
+
+TEST(BTreeSet_Tests, copiesAreIndependent)
+{
+    BTreeSet<std::string> s;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(std::to_string(i));
+    }
+
+    BTreeSet<std::string> copy{s};
+    copy.add("ONE HUNDRED");
+
+    EXPECT_EQ(100, s.size());
+    EXPECT_EQ(101, copy.size());
+    EXPECT_FALSE(s.contains(std::string{"ONE HUNDRED"}));
+    EXPECT_TRUE(copy.contains(std::string{"99"}));
+}
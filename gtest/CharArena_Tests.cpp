@@ -0,0 +1,122 @@
+// CharArena_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for CharArena, mainly that strings stay where they were
+// stored as the arena grows across many chunks.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CharArena.hpp"
+
+
+namespace
+{
+    std::string wordNumber(unsigned int i)
+    {
+        return "WORD" + std::to_string(i);
+    }
+}
+
+
+TEST(CharArena_Tests, stringsNeverMoveAsTheArenaGrows)
+{
+    CharArena arena;
+    std::vector<unsigned int> offsets;
+    std::vector<const char*> addresses;
+
+    // About 10 characters apiece is several dozen chunks' worth.
+    constexpr unsigned int WORD_COUNT = 100000;
+
+    for (unsigned int i = 0; i < WORD_COUNT; ++i)
+    {
+        std::string word = wordNumber(i);
+        offsets.push_back(arena.append(word));
+        addresses.push_back(arena.view(offsets.back(), word.length()).data());
+    }
+
+    ASSERT_GT(arena.bytes(), 32ull * CharArena::CHUNK_SIZE);
+
+    unsigned int characters = 0;
+
+    for (unsigned int i = 0; i < WORD_COUNT; ++i)
+    {
+        std::string word = wordNumber(i);
+        characters += word.length();
+
+        ASSERT_EQ(word, arena.view(offsets[i], word.length()));
+        ASSERT_EQ(addresses[i], arena.view(offsets[i], word.length()).data());
+    }
+
+    EXPECT_EQ(characters, arena.size());
+}
+
+
+TEST(CharArena_Tests, stringsLongerThanAChunkAreStoredWhole)
+{
+    CharArena arena;
+    std::string longString(CharArena::CHUNK_SIZE * 3 + 5, 'X');
+    longString.back() = 'Y';
+
+    unsigned int before = arena.append("BEFORE");
+    unsigned int offset = arena.append(longString);
+    unsigned int after = arena.append("AFTER");
+
+    EXPECT_EQ("BEFORE", arena.view(before, 6));
+    EXPECT_EQ(longString, arena.view(offset, longString.length()));
+    EXPECT_EQ("AFTER", arena.view(after, 5));
+    EXPECT_EQ(longString.length() + 11, arena.size());
+}
+
+
+TEST(CharArena_Tests, twoPiecesAreStoredTogetherAcrossChunkBoundaries)
+{
+    CharArena arena;
+    std::vector<unsigned int> offsets;
+
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        offsets.push_back(arena.append("PREFIX:", wordNumber(i)));
+    }
+
+    for (unsigned int i = 0; i < 10000; ++i)
+    {
+        std::string expected = "PREFIX:" + wordNumber(i);
+
+        ASSERT_EQ(expected, arena.view(offsets[i], expected.length()));
+        ASSERT_EQ("PREFIX:", arena.view(offsets[i], 7));
+    }
+}
+
+
+TEST(CharArena_Tests, copiesAreIndependent)
+{
+    CharArena arena;
+    std::vector<unsigned int> offsets;
+
+    for (unsigned int i = 0; i < 5000; ++i)
+    {
+        offsets.push_back(arena.append(wordNumber(i)));
+    }
+
+    CharArena copy{arena};
+    unsigned int added = copy.append("ADDED");
+
+    EXPECT_EQ(arena.size() + 5, copy.size());
+    EXPECT_EQ("ADDED", copy.view(added, 5));
+
+    for (unsigned int i = 0; i < 5000; ++i)
+    {
+        std::string word = wordNumber(i);
+
+        ASSERT_EQ(word, copy.view(offsets[i], word.length()));
+        ASSERT_NE(arena.view(offsets[i], word.length()).data(), copy.view(offsets[i], word.length()).data());
+    }
+
+    CharArena moved{std::move(copy)};
+    EXPECT_EQ("ADDED", moved.view(added, 5));
+    EXPECT_EQ(0, copy.size());
+}
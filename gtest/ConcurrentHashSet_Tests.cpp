@@ -0,0 +1,91 @@
+// ConcurrentHashSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for ConcurrentHashSet, including readers running alongside
+// a writer.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentHashSet.hpp"
+#include "StringHashing.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(ConcurrentHashSet_Tests, behavesLikeASet)
+{
+    ConcurrentHashSet<int> s{identityHash};
+    s.add(11);
+    s.add(1);
+    s.add(11);
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(11));
+    EXPECT_FALSE(s.contains(2));
+
+    ConcurrentHashSet<int> copy{s};
+    ConcurrentHashSet<int> moved{std::move(s)};
+    EXPECT_TRUE(copy.contains(1));
+    EXPECT_TRUE(moved.contains(1));
+}
+
+
+TEST(ConcurrentHashSet_Tests, readersAlwaysFindWordsAddedBeforeTheyStarted)
+{
+    ConcurrentHashSet<std::string, ProductHash> s{ProductHash{}};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add("EARLY" + std::to_string(i));
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> allFound{true};
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (running.load())
+                {
+                    for (int i = 0; i < 100; ++i)
+                    {
+                        if (!s.contains("EARLY" + std::to_string(i)))
+                        {
+                            allFound.store(false);
+                        }
+                    }
+                }
+            });
+    }
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        s.add("LATE" + std::to_string(i));
+    }
+
+    running.store(false);
+
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_TRUE(allFound.load());
+    EXPECT_EQ(20100, s.size());
+    EXPECT_TRUE(s.contains(std::string_view{"LATE19999"}));
+}
@@ -0,0 +1,155 @@
+// FlatHashSet_SanityCheckTests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Sanity-checking unit tests for the FlatHashSet implementation, in the
+// same spirit as the ones provided for HashSet.
+
+#include <string>
+#include <gtest/gtest.h>
+#include "FlatHashSet.hpp"
+
+
+namespace
+{
+    template <typename T>
+    unsigned int zeroHash(const T& t)
+    {
+        return 0;
+    }
+
+
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, inheritFromSet)
+{
+    FlatHashSet<std::string> s{zeroHash<std::string>};
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, canCopyAndMove)
+{
+    FlatHashSet<std::string> s1{zeroHash<std::string>};
+    s1.add("HELLO");
+
+    FlatHashSet<std::string> s2{s1};
+    FlatHashSet<std::string> s3{std::move(s1)};
+    EXPECT_TRUE(s2.contains(std::string{"HELLO"}));
+    EXPECT_TRUE(s3.contains(std::string{"HELLO"}));
+
+    FlatHashSet<std::string> s4{zeroHash<std::string>};
+    s4 = s2;
+    s2 = std::move(s3);
+    EXPECT_TRUE(s4.contains(std::string{"HELLO"}));
+    EXPECT_TRUE(s2.contains(std::string{"HELLO"}));
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, containsOnlyElementsAdded)
+{
+    FlatHashSet<int> s{zeroHash<int>};
+    s.add(11);
+    s.add(1);
+    s.add(5);
+    s.add(5);
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(11));
+    EXPECT_TRUE(s.contains(1));
+    EXPECT_TRUE(s.contains(5));
+    EXPECT_FALSE(s.contains(21));
+    EXPECT_FALSE(s.contains(2));
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, elementsAtIndexReportsSlotGroups)
+{
+    FlatHashSet<int> s{zeroHash<int>};
+    s.add(11);
+    s.add(1);
+    s.add(5);
+
+    EXPECT_EQ(1, s.groupCount());
+    EXPECT_EQ(3, s.elementsAtIndex(0));
+    EXPECT_EQ(0, s.elementsAtIndex(1));
+    EXPECT_TRUE(s.isElementAtIndex(11, 0));
+    EXPECT_FALSE(s.isElementAtIndex(11, 1));
+    EXPECT_FALSE(s.isElementAtIndex(21, 0));
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, growsWhileKeepingEveryElement)
+{
+    FlatHashSet<int> s{identityHash};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(10000, s.size());
+
+    unsigned int total = 0;
+
+    for (unsigned int g = 0; g < s.groupCount(); ++g)
+    {
+        total += s.elementsAtIndex(g);
+    }
+
+    EXPECT_EQ(10000, total);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        ASSERT_TRUE(s.contains(i));
+    }
+
+    EXPECT_FALSE(s.contains(10000));
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, hashesWithConstantLowBitsStillSpreadAcrossGroups)
+{
+    FlatHashSet<int> s{[](const int& i) { return static_cast<unsigned int>(i) << 20; }};
+    s.reserve(16000);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+
+    // With so few elements for so many groups, no group should come close
+    // to filling up unless the elements all start probing at the same one.
+    for (unsigned int g = 0; g < s.groupCount(); ++g)
+    {
+        ASSERT_LT(s.elementsAtIndex(g), 8);
+    }
+}
+
+
+TEST(FlatHashSet_SanityCheckTests, growingDoesNotHashElementsAgain)
+{
+    unsigned int hashes = 0;
+    FlatHashSet<std::string> s{
+        [&](const std::string& element)
+        {
+            ++hashes;
+            return static_cast<unsigned int>(std::hash<std::string>{}(element));
+        }};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add("a word long enough to be stored outside the string " + std::to_string(i));
+    }
+
+    EXPECT_EQ(1000, hashes);
+    EXPECT_GT(s.groupCount(), 1);
+    EXPECT_TRUE(s.contains(std::string{"a word long enough to be stored outside the string 999"}));
+}
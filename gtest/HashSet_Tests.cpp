@@ -0,0 +1,302 @@
+// HashSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for HashSet behavior beyond what the sanity-checking tests
+// cover, mainly its resizing.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+
+
+    // A hash function object that counts how many times it's called.
+    // Copies of it (such as the one a HashSet keeps) share the count.
+    struct CountingHash
+    {
+        unsigned int* calls = nullptr;
+
+        unsigned int operator()(const int& i) const
+        {
+            ++*calls;
+            return static_cast<unsigned int>(i);
+        }
+    };
+
+
+    unsigned int totalElementsAtIndices(const HashSet<int>& s, unsigned int capacity)
+    {
+        unsigned int total = 0;
+
+        for (unsigned int i = 0; i < capacity; ++i)
+        {
+            total += s.elementsAtIndex(i);
+        }
+
+        return total;
+    }
+}
+
+
+TEST(HashSet_Tests, growsToTwiceCapacityPlusOne)
+{
+    HashSet<int> s{identityHash};
+
+    for (int i = 0; i < 8; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_TRUE(s.isElementAtIndex(7, 7));
+
+    s.add(8);
+    s.add(20);
+
+    EXPECT_EQ(1, s.elementsAtIndex(20));
+    EXPECT_EQ(0, s.elementsAtIndex(21));
+    EXPECT_TRUE(s.isElementAtIndex(20, 20));
+    EXPECT_FALSE(s.isElementAtIndex(20, 0));
+}
+
+
+TEST(HashSet_Tests, incrementalResizingKeepsEveryElementVisible)
+{
+    HashSet<int> s{identityHash, HashSetResizing::Incremental};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add(i * 7);
+
+        ASSERT_TRUE(s.contains(0));
+        ASSERT_TRUE(s.contains(i * 7));
+    }
+
+    EXPECT_EQ(5000, s.size());
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        ASSERT_TRUE(s.contains(i * 7));
+        ASSERT_FALSE(s.contains(i * 7 + 1));
+    }
+}
+
+
+TEST(HashSet_Tests, incrementalResizingCanBeCopiedMidway)
+{
+    HashSet<int> s{identityHash, HashSetResizing::Incremental};
+
+    for (int i = 0; i < 9; ++i)
+    {
+        s.add(i);
+    }
+
+    HashSet<int> copy{s};
+    HashSet<int> moved{std::move(s)};
+
+    for (int i = 0; i < 9; ++i)
+    {
+        EXPECT_TRUE(copy.contains(i));
+        EXPECT_TRUE(moved.contains(i));
+    }
+
+    EXPECT_EQ(9, totalElementsAtIndices(copy, 21));
+}
+
+
+TEST(HashSet_Tests, resizingNeverCallsTheHashFunctionAgain)
+{
+    constexpr int ELEMENT_COUNT = 1000;
+
+    for (HashSetResizing resizing : {HashSetResizing::AllAtOnce, HashSetResizing::Incremental})
+    {
+        unsigned int calls = 0;
+        HashSet<int, CountingHash> s{CountingHash{&calls}, resizing};
+
+        // 1000 elements starting from a capacity of 10 cross seven resizes.
+        for (int i = 0; i < ELEMENT_COUNT; ++i)
+        {
+            s.add(i * 7);
+        }
+
+        EXPECT_EQ(ELEMENT_COUNT, s.size());
+        EXPECT_EQ(ELEMENT_COUNT, calls);
+
+        s.add(0);
+        EXPECT_EQ(ELEMENT_COUNT + 1, calls);
+    }
+}
+
+
+TEST(HashSet_Tests, copiesOfStringSetsAreIndependent)
+{
+    HashSet<std::string> s{[](const std::string& str) { return static_cast<unsigned int>(str.length()); }};
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    HashSet<std::string> copy{s};
+    s.add("ONLYINORIGINAL");
+
+    EXPECT_EQ(3000, copy.size());
+    EXPECT_FALSE(copy.contains(std::string{"ONLYINORIGINAL"}));
+    EXPECT_TRUE(s.contains(std::string{"ONLYINORIGINAL"}));
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        ASSERT_TRUE(copy.contains("WORD" + std::to_string(i)));
+    }
+}
+
+
+TEST(HashSet_Tests, reserveSizesTheArrayOnceAlongTheGrowthSequence)
+{
+    HashSet<int> s{identityHash};
+    s.add(5);
+    s.reserve(30);
+
+    EXPECT_TRUE(s.isElementAtIndex(5, 5));
+    EXPECT_EQ(0, s.elementsAtIndex(42));
+
+    s.add(42);
+    EXPECT_TRUE(s.isElementAtIndex(42, 42));
+    EXPECT_EQ(0, s.elementsAtIndex(43));
+}
+
+
+TEST(HashSet_Tests, canConstructFromRange)
+{
+    std::vector<std::string> words{"BOO", "HELLO", "THERE", "HELLO"};
+    HashSet<std::string> s{
+        [](const std::string& str) { return static_cast<unsigned int>(str.length()); },
+        words.begin(), words.end()};
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(std::string{"BOO"}));
+    EXPECT_TRUE(s.contains(std::string{"THERE"}));
+}
+
+
+TEST(HashSet_Tests, functionObjectHashMatchesHashFunction)
+{
+    HashSet<std::string> byFunction{hashStringAsProduct};
+    HashSet<std::string, ProductHash> byObject{ProductHash{}};
+
+    for (const char* word : {"BOO", "HELLO", "THERE", "ZYZZYVA"})
+    {
+        byFunction.add(word);
+        byObject.add(word);
+    }
+
+    for (unsigned int i = 0; i < HashSet<std::string>::DEFAULT_CAPACITY; ++i)
+    {
+        EXPECT_EQ(byFunction.elementsAtIndex(i), byObject.elementsAtIndex(i));
+    }
+
+    std::string buffer = "HELLOTHERE";
+    EXPECT_TRUE(byObject.contains(std::string_view{buffer}.substr(5)));
+    EXPECT_FALSE(byObject.contains(std::string_view{buffer}));
+
+    HashSet<std::string, ProductHash> moved{std::move(byObject)};
+    EXPECT_TRUE(moved.contains(std::string{"ZYZZYVA"}));
+}
+
+
+TEST(HashSet_Tests, statsDescribeTheShapeOfTheArray)
+{
+    HashSet<int> s{identityHash};
+    s.reserve(6);
+
+    // With capacity 10, these land in chains of lengths 3, 2, and 1.
+    for (int i : {0, 10, 20, 1, 11, 2})
+    {
+        s.add(i);
+    }
+
+    HashSetStats stats = s.stats();
+
+    EXPECT_EQ(10, stats.capacity);
+    EXPECT_EQ(6, stats.size);
+    EXPECT_DOUBLE_EQ(0.6, stats.loadFactor);
+    EXPECT_EQ(3, stats.longestChain);
+    EXPECT_EQ((std::vector<unsigned int>{7, 1, 1, 1}), stats.chainLengths);
+
+    EXPECT_DOUBLE_EQ(1.3, stats.expectedSuccessfulProbes);
+    EXPECT_DOUBLE_EQ(10.0 / 6.0, stats.measuredSuccessfulProbes);
+    EXPECT_DOUBLE_EQ(1.6, stats.expectedUnsuccessfulProbes);
+    EXPECT_DOUBLE_EQ(14.0 / 6.0, stats.measuredUnsuccessfulProbes);
+}
+
+
+TEST(HashSet_Tests, containsManyMatchesContains)
+{
+    HashSet<std::string, ProductHash> s{ProductHash{}};
+
+    for (const char* word : {"BOO", "HELLO", "THERE", "ZYZZYVA"})
+    {
+        s.add(word);
+    }
+
+    std::vector<std::string_view> candidates;
+
+    for (const char* word : {"BOO", "BOOT", "HELLO", "", "THERE", "THEIR", "ZYZZYVA", "ZYZZYV"})
+    {
+        candidates.push_back(word);
+    }
+
+    for (int i = 0; i < 20; ++i)
+    {
+        candidates.push_back(i % 2 == 0 ? "HELLO" : "HALLO");
+    }
+
+    std::vector<unsigned int> hashes(candidates.size());
+    hashMany(candidates.data(), candidates.size(), hashes.data());
+
+    bool results[28];
+    s.containsMany(candidates.data(), hashes.data(), candidates.size(), results);
+
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        EXPECT_EQ(s.contains(candidates[i]), results[i]);
+    }
+
+    EXPECT_TRUE(results[0]);
+    EXPECT_FALSE(results[1]);
+}
+
+
+TEST(HashSet_Tests, forEachVisitsElementsInTheOrderAdded)
+{
+    HashSet<std::string, ProductHash> words{ProductHash{}};
+
+    for (const char* word : {"THERE", "BOO", "THERE", "HELLO"})
+    {
+        words.add(word);
+    }
+
+    std::vector<std::string> visited;
+    words.forEach([&](std::string_view word) { visited.emplace_back(word); });
+
+    EXPECT_EQ((std::vector<std::string>{"THERE", "BOO", "HELLO"}), visited);
+
+    HashSet<int> numbers{identityHash};
+    numbers.add(3);
+    numbers.add(1);
+
+    std::vector<int> visitedNumbers;
+    numbers.forEach([&](const int& number) { visitedNumbers.push_back(number); });
+
+    EXPECT_EQ((std::vector<int>{3, 1}), visitedNumbers);
+}
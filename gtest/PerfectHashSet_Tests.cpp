@@ -0,0 +1,100 @@
+// PerfectHashSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for PerfectHashSet, both before and after it's built.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "PerfectHashSet.hpp"
+
+
+namespace
+{
+    std::vector<std::string> makeWords(const std::string& prefix, unsigned int count)
+    {
+        std::vector<std::string> words;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            words.push_back(prefix + std::to_string(i));
+        }
+
+        return words;
+    }
+}
+
+
+TEST(PerfectHashSet_Tests, findsElementsBeforeAndAfterBuilding)
+{
+    PerfectHashSet s;
+    s.add("CAT");
+    s.add("DOG");
+    s.add("CAT");
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(std::string{"CAT"}));
+    EXPECT_FALSE(s.contains(std::string{"COW"}));
+
+    s.build();
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_EQ(1, s.bucketCount());
+    EXPECT_TRUE(s.contains(std::string{"CAT"}));
+    EXPECT_TRUE(s.contains(std::string_view{"DOG"}));
+    EXPECT_FALSE(s.contains(std::string{"COW"}));
+}
+
+
+TEST(PerfectHashSet_Tests, addAllBuildsEveryElementIntoItsOwnSlot)
+{
+    std::vector<std::string> words = makeWords("WORD", 20000);
+
+    PerfectHashSet s;
+    s.addAll(words.begin(), words.end());
+
+    EXPECT_EQ(20000, s.size());
+    EXPECT_EQ(4000, s.bucketCount());
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(s.contains(word));
+    }
+
+    for (const std::string& word : makeWords("MISSING", 20000))
+    {
+        ASSERT_FALSE(s.contains(word));
+    }
+}
+
+
+TEST(PerfectHashSet_Tests, addingAfterBuildingRebuildsEverything)
+{
+    std::vector<std::string> first = makeWords("A", 1000);
+    std::vector<std::string> second = makeWords("B", 1000);
+
+    PerfectHashSet s;
+    s.addAll(first.begin(), first.end());
+    s.addAll(first.begin(), first.end());
+    EXPECT_EQ(1000, s.size());
+
+    s.addAll(second.begin(), second.end());
+    EXPECT_EQ(2000, s.size());
+
+    PerfectHashSet copy{s};
+    PerfectHashSet moved{std::move(s)};
+
+    for (const std::string& word : first)
+    {
+        ASSERT_TRUE(copy.contains(word));
+        ASSERT_TRUE(moved.contains(word));
+    }
+
+    for (const std::string& word : second)
+    {
+        ASSERT_TRUE(copy.contains(word));
+        ASSERT_TRUE(moved.contains(word));
+    }
+}
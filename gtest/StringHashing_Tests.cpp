@@ -0,0 +1,186 @@
+// StringHashing_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the hash functions in StringHashing.hpp that go beyond
+// the ones that were provided.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "StringHashing.hpp"
+
+
+TEST(StringHashing_Tests, fastHashAgreesWithItsFunctionVersion)
+{
+    for (const char* word : {"", "A", "ABC", "ABCD", "SPELLING", "ABCDEFGHIJKLMNOPQ"})
+    {
+        EXPECT_EQ(hashStringAsFast(word), FastHash{}(word));
+    }
+}
+
+
+TEST(StringHashing_Tests, fastHashDistinguishesEveryLengthAndPosition)
+{
+    // Changing any one byte of keys of every length up to 200 (which
+    // covers the short, medium, and long paths) should change the hash.
+    std::string key(200, 'A');
+
+    for (std::size_t length = 1; length <= key.size(); ++length)
+    {
+        std::string_view prefix{key.data(), length};
+        unsigned int original = FastHash{}(prefix);
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            key[i] = 'B';
+            ASSERT_NE(original, FastHash{}(prefix)) << "length " << length << ", position " << i;
+            key[i] = 'A';
+        }
+    }
+}
+
+
+TEST(StringHashing_Tests, fastHashLongKeyKernelsAgree)
+{
+    std::string data;
+
+    for (int i = 0; i < 256; ++i)
+    {
+        data += static_cast<char>(i * 31 + 7);
+    }
+
+    std::uint64_t scalar[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    impl_::StringHashing__accumulateScalar(scalar, data.data(), 4);
+
+#ifdef __SSE2__
+    std::uint64_t sse2[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    impl_::StringHashing__accumulateSse2(sse2, data.data(), 4);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(scalar[i], sse2[i]);
+    }
+#endif
+}
+
+
+TEST(StringHashing_Tests, rollingProductHashMatchesHashingEachEdit)
+{
+    RollingProductHash hashes;
+
+    for (std::string word : {"A", "AB", "SPELLING", "ANTIDISESTABLISHMENTARIANISM"})
+    {
+        hashes.assign(word);
+        EXPECT_EQ(hashStringAsProduct(word), hashes.hash());
+
+        for (std::size_t i = 0; i <= word.length(); ++i)
+        {
+            EXPECT_EQ(hashStringAsProduct(word.substr(0, i)), hashes.substring(0, i));
+            EXPECT_EQ(hashStringAsProduct(word.substr(i)), hashes.substring(i, word.length() - i));
+
+            std::string edited = word;
+            edited.insert(i, 1, 'Q');
+            EXPECT_EQ(hashStringAsProduct(edited), hashes.inserted(i, 'Q'));
+
+            if (i < word.length())
+            {
+                edited = word;
+                edited[i] = 'Z';
+                EXPECT_EQ(hashStringAsProduct(edited), hashes.replaced(i, 'Z'));
+
+                edited = word;
+                edited.erase(i, 1);
+                EXPECT_EQ(hashStringAsProduct(edited), hashes.erased(i));
+            }
+
+            if (i + 1 < word.length())
+            {
+                edited = word;
+                std::swap(edited[i], edited[i + 1]);
+                EXPECT_EQ(hashStringAsProduct(edited), hashes.swapped(i));
+            }
+        }
+    }
+}
+
+
+TEST(StringHashing_Tests, sipHashMatchesTheReferenceTestVector)
+{
+    // From the SipHash paper: the key is the bytes 00 through 0f, and the
+    // message is the bytes 00 through 0e.
+    std::string message;
+
+    for (int i = 0; i < 15; ++i)
+    {
+        message += static_cast<char>(i);
+    }
+
+    SipHash hash{0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull};
+    EXPECT_EQ(0xa129ca6149be45e5ull, hash.hash64(message));
+}
+
+
+TEST(StringHashing_Tests, seedsChangeHashes)
+{
+    EXPECT_EQ(processHashSeed(), processHashSeed());
+    EXPECT_EQ(FastHash{}("SPELLING"), FastHash{0}("SPELLING"));
+    EXPECT_NE(FastHash{1}("SPELLING"), FastHash{2}("SPELLING"));
+    EXPECT_NE(SipHash(1, 2)("SPELLING"), SipHash(2, 1)("SPELLING"));
+}
+
+
+TEST(StringHashing_Tests, hashManyKernelsAgreeWithProductHash)
+{
+    // Mixed lengths (so lanes finish at different times), including an
+    // empty string and characters that are negative as chars.
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 37; ++i)
+    {
+        std::string word;
+
+        for (int j = 0; j < (i * 7) % 23; ++j)
+        {
+            word += static_cast<char>(i * 13 + j * 29 + 'A');
+        }
+
+        words.push_back(word);
+    }
+
+    std::vector<std::string_view> views{words.begin(), words.end()};
+    std::vector<unsigned int> hashes(views.size());
+
+    auto expectProductHashes =
+        [&]()
+        {
+            for (std::size_t i = 0; i < views.size(); ++i)
+            {
+                EXPECT_EQ(ProductHash{}(views[i]), hashes[i]);
+            }
+
+            hashes.assign(views.size(), 0);
+        };
+
+    hashMany(views.data(), views.size(), hashes.data());
+    expectProductHashes();
+
+    impl_::StringHashing__hashManyScalar(views.data(), views.size(), hashes.data());
+    expectProductHashes();
+
+#ifdef __SSE2__
+    impl_::StringHashing__hashManySse2(views.data(), views.size(), hashes.data());
+    expectProductHashes();
+#endif
+
+#ifdef STRINGHASHING_AVX2_KERNEL
+    if (impl_::StringHashing__avx2Supported())
+    {
+        impl_::StringHashing__hashManyAvx2(views.data(), views.size(), hashes.data());
+        expectProductHashes();
+    }
+#endif
+}
@@ -0,0 +1,146 @@
+// StringViewContains_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the std::string_view overload of Set::contains(), which
+// every set of strings should answer the same way as the ElementType one,
+// and for the const char* overload that keeps string literals unambiguous.
+
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "ArenaAVLSet.hpp"
+#include "BTreeSet.hpp"
+#include "ConcurrentHashSet.hpp"
+#include "EmptySet.hpp"
+#include "FlatHashSet.hpp"
+#include "HashSet.hpp"
+#include "PerfectHashSet.hpp"
+#include "StringHashing.hpp"
+#include "StripedHashSet.hpp"
+#include "VectorSet.hpp"
+
+
+namespace
+{
+    void expectViewLookups(Set<std::string>& set)
+    {
+        set.add("BOO");
+        set.add("HELLO");
+        set.add("THERE");
+
+        std::string buffer = "HELLOTHERE";
+        std::string_view view{buffer};
+
+        EXPECT_TRUE(set.contains(view.substr(0, 5)));
+        EXPECT_TRUE(set.contains(view.substr(5)));
+        EXPECT_FALSE(set.contains(view.substr(0, 4)));
+        EXPECT_FALSE(set.contains(view));
+        EXPECT_FALSE(set.contains(std::string_view{}));
+    }
+
+
+    // Looks up string literals and a const char* both on the concrete set
+    // and through a reference to Set<std::string>.
+    template <typename ConcreteSet>
+    void expectLiteralLookups(ConcreteSet& set)
+    {
+        set.add("BOO");
+        set.add("HELLO");
+        set.finishAdding();
+
+        const char* missing = "THERE";
+
+        EXPECT_TRUE(set.contains("BOO"));
+        EXPECT_FALSE(set.contains("BOOT"));
+        EXPECT_FALSE(set.contains(missing));
+
+        const Set<std::string>& base = set;
+
+        EXPECT_TRUE(base.contains("HELLO"));
+        EXPECT_FALSE(base.contains(""));
+        EXPECT_FALSE(base.contains(missing));
+    }
+}
+
+
+TEST(StringViewContains_Tests, hashSet)
+{
+    HashSet<std::string> set{hashStringAsProduct};
+    expectViewLookups(set);
+}
+
+
+TEST(StringViewContains_Tests, flatHashSet)
+{
+    FlatHashSet<std::string> set{hashStringAsProduct};
+    expectViewLookups(set);
+}
+
+
+TEST(StringViewContains_Tests, avlSet)
+{
+    AVLSet<std::string> set;
+    expectViewLookups(set);
+}
+
+
+TEST(StringViewContains_Tests, vectorSet)
+{
+    VectorSet<std::string> set;
+    expectViewLookups(set);
+}
+
+
+TEST(StringViewContains_Tests, emptySetContainsNothing)
+{
+    EmptySet<std::string> set;
+    EXPECT_FALSE(set.contains(std::string_view{"HELLO"}));
+}
+
+
+TEST(StringViewContains_Tests, nonStringSetsContainNoViews)
+{
+    HashSet<int> set{[](const int& i) { return static_cast<unsigned int>(i); }};
+    set.add(1);
+    EXPECT_FALSE(set.contains(std::string_view{"1"}));
+}
+
+
+TEST(StringViewContains_Tests, stringLiteralsAreLookedUpInEverySetOfStrings)
+{
+    HashSet<std::string> hashSet{hashStringAsProduct};
+    expectLiteralLookups(hashSet);
+
+    HashSet<std::string, ProductHash> inlineHashSet{ProductHash{}};
+    expectLiteralLookups(inlineHashSet);
+
+    FlatHashSet<std::string> flatHashSet{hashStringAsProduct};
+    expectLiteralLookups(flatHashSet);
+
+    StripedHashSet<std::string, ProductHash> stripedHashSet{ProductHash{}};
+    expectLiteralLookups(stripedHashSet);
+
+    ConcurrentHashSet<std::string> concurrentHashSet{hashStringAsProduct};
+    expectLiteralLookups(concurrentHashSet);
+
+    PerfectHashSet perfectHashSet;
+    expectLiteralLookups(perfectHashSet);
+
+    AVLSet<std::string> avlSet;
+    expectLiteralLookups(avlSet);
+
+    ArenaAVLSet<std::string> arenaAVLSet;
+    expectLiteralLookups(arenaAVLSet);
+
+    BTreeSet<std::string> bTreeSet;
+    expectLiteralLookups(bTreeSet);
+
+    VectorSet<std::string> vectorSet;
+    expectLiteralLookups(vectorSet);
+
+    EmptySet<std::string> emptySet;
+    EXPECT_FALSE(emptySet.contains("HELLO"));
+}
@@ -0,0 +1,153 @@
+// StripedHashSet_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for StripedHashSet, including several threads adding to it
+// at once.
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "StringHashing.hpp"
+#include "StripedHashSet.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(StripedHashSet_Tests, behavesLikeASet)
+{
+    StripedHashSet<int> s{identityHash, 4};
+    s.add(11);
+    s.add(1);
+    s.add(11);
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(11));
+    EXPECT_FALSE(s.contains(2));
+
+    StripedHashSet<int> copy{s};
+    StripedHashSet<int> moved{std::move(s)};
+    EXPECT_TRUE(copy.contains(1));
+    EXPECT_TRUE(moved.contains(1));
+}
+
+
+TEST(StripedHashSet_Tests, stripeCountIsRoundedUpToAPowerOfTwo)
+{
+    StripedHashSet<int> s{identityHash, 5};
+    EXPECT_EQ(8, s.stripeCount());
+    EXPECT_EQ(16, s.capacity());
+}
+
+
+TEST(StripedHashSet_Tests, growsByDoublingOnceMoreThanFourFifthsFull)
+{
+    StripedHashSet<int> s{identityHash, 4};
+
+    for (int i = 0; i < 12; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(16, s.capacity());
+
+    s.add(12);
+    s.add(13);
+
+    EXPECT_EQ(32, s.capacity());
+
+    for (int i = 0; i < 14; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(StripedHashSet_Tests, growsByTheTotalCountNotOneStripesEstimate)
+{
+    // Every add() here is the first in its stripe, so one stripe's count
+    // times the number of stripes already estimates a full table.
+    StripedHashSet<int> s{identityHash, 64};
+
+    for (int i = 0; i < 51; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(64, s.capacity());
+    EXPECT_EQ(51, s.size());
+
+    s.add(51);
+
+    EXPECT_EQ(128, s.capacity());
+    EXPECT_EQ(52, s.size());
+}
+
+
+TEST(StripedHashSet_Tests, reserveSizesTheTableOnce)
+{
+    StripedHashSet<int> s{identityHash};
+    s.reserve(1000);
+    EXPECT_EQ(2048, s.capacity());
+}
+
+
+TEST(StripedHashSet_Tests, concurrentAddsAreAllKept)
+{
+    StripedHashSet<std::string, ProductHash> s{ProductHash{}, 8};
+    std::vector<std::thread> writers;
+
+    for (int w = 0; w < 4; ++w)
+    {
+        writers.emplace_back(
+            [&s, w]()
+            {
+                // Every writer also adds the shared words, which must
+                // still only be kept once.
+                for (int i = 0; i < 5000; ++i)
+                {
+                    s.add("W" + std::to_string(w) + "_" + std::to_string(i));
+                    s.add("SHARED" + std::to_string(i));
+                }
+            });
+    }
+
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+
+    EXPECT_EQ(25000, s.size());
+    EXPECT_TRUE(s.contains(std::string{"W3_4999"}));
+    EXPECT_TRUE(s.contains(std::string_view{"SHARED0"}));
+}
+
+
+TEST(StripedHashSet_Tests, addAllParallelAddsTheWholeRange)
+{
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        words.push_back("WORD" + std::to_string(i));
+    }
+
+    StripedHashSet<std::string, ProductHash> s{ProductHash{}};
+    s.addAllParallel(words.begin(), words.end(), 3);
+
+    EXPECT_EQ(10000, s.size());
+
+    for (const std::string& word : words)
+    {
+        ASSERT_TRUE(s.contains(word));
+    }
+}
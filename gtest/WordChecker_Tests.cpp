@@ -0,0 +1,78 @@
+// WordChecker_Tests.cpp
+//
+// ICS 46 Winter 2022
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WordChecker beyond what the sanity-checking tests cover,
+// mainly that it suggests the same words whichever kind of Set it's
+// given.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "StringHashing.hpp"
+#include "VectorSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    const std::vector<std::string> WORDS{
+        "ANT", "ANTS", "CAT", "CATS", "CUT", "DOG", "GOD", "HAT", "RAT", "SAT",
+        "THE", "THEN", "TEN", "HEN", "CATDOG", "A", "AT", "DOGS"};
+
+
+    std::vector<std::string> sortedSuggestions(const Set<std::string>& words, const std::string& word)
+    {
+        std::vector<std::string> suggestions = WordChecker{words}.findSuggestions(word);
+        std::sort(suggestions.begin(), suggestions.end());
+        return suggestions;
+    }
+}
+
+
+TEST(WordChecker_Tests, hashSetsWithRollingHashesSuggestTheSameWords)
+{
+    VectorSet<std::string> vectorSet;
+    HashSet<std::string> functionSet{hashStringAsProduct};
+    HashSet<std::string, ProductHash> inlineSet{ProductHash{}};
+    HashSet<std::string> fnvSet{[](const std::string& word) { return Fnv1aHash{}(word); }};
+
+    for (const std::string& word : WORDS)
+    {
+        vectorSet.add(word);
+        functionSet.add(word);
+        inlineSet.add(word);
+        fnvSet.add(word);
+    }
+
+    for (const char* word : {"CAAT", "TAC", "CT", "DGO", "THNE", "CATSDOG", "ATN", "HTE", "XYZ"})
+    {
+        std::vector<std::string> expected = sortedSuggestions(vectorSet, word);
+
+        EXPECT_EQ(expected, sortedSuggestions(functionSet, word)) << word;
+        EXPECT_EQ(expected, sortedSuggestions(inlineSet, word)) << word;
+        EXPECT_EQ(expected, sortedSuggestions(fnvSet, word)) << word;
+    }
+}
+
+
+TEST(WordChecker_Tests, avlSetsPruneCandidatesWithoutLosingSuggestions)
+{
+    VectorSet<std::string> vectorSet;
+    AVLSet<std::string> avlSet;
+
+    for (const std::string& word : WORDS)
+    {
+        vectorSet.add(word);
+        avlSet.add(word);
+    }
+
+    for (const char* word : {"CAAT", "TAC", "CT", "DGO", "THNE", "CATSDOG", "ATN", "HTE", "XYZ", "ZAT", "DOGZ", ""})
+    {
+        EXPECT_EQ(sortedSuggestions(vectorSet, word), sortedSuggestions(avlSet, word)) << word;
+    }
+}
@@ -11,6 +11,7 @@
 #ifndef EMPTYSET_HPP
 #define EMPTYSET_HPP
 
+#include <string_view>
 #include "Set.hpp"
 
 
@@ -21,7 +22,9 @@ class EmptySet : public Set<ElementType>
 public:
     bool isImplemented() const noexcept override;
     void add(const ElementType& element) override;
+    using Set<ElementType>::contains;
     bool contains(const ElementType& element) const override;
+    bool contains(std::string_view element) const override;
     unsigned int size() const noexcept override;
 };
 
@@ -46,6 +49,13 @@ bool EmptySet<ElementType>::contains(const ElementType& element) const
 }
 
 
+template <typename ElementType>
+bool EmptySet<ElementType>::contains(std::string_view element) const
+{
+    return false;
+}
+
+
 template <typename ElementType>
 unsigned int EmptySet<ElementType>::size() const noexcept
 {
@@ -11,6 +11,10 @@
 #ifndef SET_HPP
 #define SET_HPP
 
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
 
 
 template <typename ElementType>
@@ -39,11 +43,102 @@ public:
     virtual bool contains(const ElementType& element) const = 0;
 
 
+    // contains() can also be asked about a std::string_view, so that callers
+    // holding characters in a reusable buffer don't have to build a whole
+    // ElementType just to ask a yes/no question.  By default, an ElementType
+    // is built from the view anyway (or, if that's not possible, the answer
+    // is false); sets of strings override this with a lookup that doesn't
+    // allocate.
+    virtual bool contains(std::string_view element) const;
+
+
+    // contains() can also be asked about a C-style string, such as a string
+    // literal, which would otherwise convert equally well to either of the
+    // other two overloads.  It asks the std::string_view overload.  Every
+    // subclass that overrides contains() brings this one back into scope
+    // with "using Set<ElementType>::contains;".
+    bool contains(const char* element) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept = 0;
+
+
+    // reserve() tells the set that it will soon hold the given number of
+    // elements in total, so that it can size itself once rather than
+    // growing repeatedly along the way.  By default, it does nothing.
+    virtual void reserve(unsigned int elementCount);
+
+
+    // finishAdding() tells the set that no more elements will be added
+    // for a while, so that a set that's built in bulk (such as
+    // PerfectHashSet) can build itself.  By default, it does nothing.
+    virtual void finishAdding();
+
+
+    // addAll() adds every element in the range [begin, end) to the set,
+    // then calls finishAdding().  When the length of the range can be
+    // determined without consuming it, room for that many more elements
+    // is reserved first.
+    template <typename Iterator>
+    void addAll(Iterator begin, Iterator end);
 };
 
 
 
+template <typename ElementType>
+bool Set<ElementType>::contains(std::string_view element) const
+{
+    if constexpr (std::is_constructible_v<ElementType, std::string_view>)
+    {
+        return contains(ElementType{element});
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+template <typename ElementType>
+bool Set<ElementType>::contains(const char* element) const
+{
+    return contains(std::string_view{element});
+}
+
+
+template <typename ElementType>
+void Set<ElementType>::reserve(unsigned int elementCount)
+{
+}
+
+
+template <typename ElementType>
+void Set<ElementType>::finishAdding()
+{
+}
+
+
+template <typename ElementType>
+template <typename Iterator>
+void Set<ElementType>::addAll(Iterator begin, Iterator end)
+{
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+    {
+        reserve(size() + static_cast<unsigned int>(std::distance(begin, end)));
+    }
+
+    for (; begin != end; ++begin)
+    {
+        add(*begin);
+    }
+
+    finishAdding();
+}
+
+
+
 #endif
 
@@ -3,16 +3,25 @@
 // ICS 46 Winter 2022
 // Project #4: Set the Controls for the Heart of the Sun
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 #include "SpellCheckShell.hpp"
 #include "AVLSet.hpp"
+#include "ArenaAVLSet.hpp"
+#include "BTreeSet.hpp"
 #include "EmptySet.hpp"
+#include "FlatHashSet.hpp"
+#include "FrozenAVLSet.hpp"
 #include "HashSet.hpp"
+#include "HashSetStats.hpp"
 #include "OutputSpellCheckerListener.hpp"
+#include "PerfectHashSet.hpp"
 #include "Set.hpp"
 #include "SkipListSet.hpp"
 #include "SpellChecker.hpp"
@@ -54,6 +63,18 @@ namespace
         {
             return std::make_unique<AVLSet<std::string>>();
         }
+        else if (setType == "AVL FROZEN")
+        {
+            return std::make_unique<FrozenAVLSet<std::string>>();
+        }
+        else if (setType == "AVL ARENA")
+        {
+            return std::make_unique<ArenaAVLSet<std::string>>();
+        }
+        else if (setType == "BTREE")
+        {
+            return std::make_unique<BTreeSet<std::string>>();
+        }
         else if (setType == "EMPTY")
         {
             return std::make_unique<EmptySet<std::string>>();
@@ -70,6 +91,34 @@ namespace
         {
             return std::make_unique<HashSet<std::string>>(hashStringAsProduct);
         }
+        else if (setType == "HASH PRODUCT INLINE")
+        {
+            return std::make_unique<HashSet<std::string, ProductHash>>(ProductHash{});
+        }
+        else if (setType == "HASH FNV INLINE")
+        {
+            return std::make_unique<HashSet<std::string, Fnv1aHash>>(Fnv1aHash{});
+        }
+        else if (setType == "HASH FAST")
+        {
+            return std::make_unique<HashSet<std::string, FastHash>>(FastHash{});
+        }
+        else if (setType == "HASH SEEDED")
+        {
+            return std::make_unique<HashSet<std::string, FastHash>>(FastHash{processHashSeed()});
+        }
+        else if (setType == "HASH SIP")
+        {
+            return std::make_unique<HashSet<std::string, SipHash>>(SipHash{});
+        }
+        else if (setType == "HASH PERFECT")
+        {
+            return std::make_unique<PerfectHashSet>();
+        }
+        else if (setType == "HASH FLAT")
+        {
+            return std::make_unique<FlatHashSet<std::string>>(hashStringAsProduct);
+        }
         else if (setType == "VECTOR")
         {
             return std::make_unique<VectorSet<std::string>>();
@@ -85,6 +134,28 @@ namespace
     }
 
     
+    // Adds every word to the word set.  An AVLSet or a BTreeSet is built
+    // all at once from the words, which the word file keeps in sorted
+    // order, rather than one rotation- or split-prone add() at a time.
+    void loadWordSet(Set<std::string>& wordSet, const std::vector<std::string>& words)
+    {
+        if (auto avlSet = dynamic_cast<AVLSet<std::string>*>(&wordSet))
+        {
+            avlSet->addSorted(words.begin(), words.end());
+            avlSet->finishAdding();
+        }
+        else if (auto bTreeSet = dynamic_cast<BTreeSet<std::string>*>(&wordSet))
+        {
+            bTreeSet->addSorted(words.begin(), words.end());
+            bTreeSet->finishAdding();
+        }
+        else
+        {
+            wordSet.addAll(words.begin(), words.end());
+        }
+    }
+
+
     void requireNonEmptyFileExists(const std::string& filePath)
     {
         std::ifstream file{filePath};
@@ -147,10 +218,8 @@ namespace
         std::cout << std::endl;
         std::cout << "Loading word set from " << wordFilePath << " ..." << std::endl;
 
-        for (const std::string& word : WordSetLoader{}.load(wordFilePath))
-        {
-            wordSet.add(word);
-        }
+        std::vector<std::string> words = WordSetLoader{}.load(wordFilePath);
+        loadWordSet(wordSet, words);
 
         std::cout << "Checking spelling in " << textFilePath << " ..." << std::endl;
 
@@ -161,6 +230,104 @@ namespace
     }
 
 
+    void printHashSetStats(const HashSetStats& stats)
+    {
+        std::cout << std::endl;
+        std::cout << "HASH TABLE" << std::endl;
+
+        std::cout << std::left << std::setw(24) << "Capacity" << stats.capacity << std::endl;
+        std::cout << std::left << std::setw(24) << "Size" << stats.size << std::endl;
+        std::cout << std::left << std::setw(24) << "Load Factor"
+                  << std::fixed << std::setprecision(3) << stats.loadFactor << std::endl;
+        std::cout << std::left << std::setw(24) << "Longest Chain" << stats.longestChain << std::endl;
+
+        std::cout << std::endl;
+        std::cout << "                    Expected     Measured" << std::endl;
+
+        std::cout << std::left << std::setw(16) << "Hit Probes"
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << stats.expectedSuccessfulProbes
+                  << std::setw(13) << stats.measuredSuccessfulProbes << std::endl;
+
+        std::cout << std::left << std::setw(16) << "Miss Probes"
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << stats.expectedUnsuccessfulProbes
+                  << std::setw(13) << stats.measuredUnsuccessfulProbes << std::endl;
+
+        // Lengths beyond 4 are grouped into ranges that double in size, so
+        // even a badly-skewed table prints in a few lines.
+        std::cout << std::endl;
+        std::cout << "ChainLength      Chains" << std::endl;
+
+        unsigned int low = 0;
+
+        while (low < stats.chainLengths.size())
+        {
+            unsigned int high = low < 5 ? low : low * 2 - 2;
+            high = std::min(high, static_cast<unsigned int>(stats.chainLengths.size() - 1));
+
+            unsigned int chains = 0;
+
+            for (unsigned int length = low; length <= high; ++length)
+            {
+                chains += stats.chainLengths[length];
+            }
+
+            if (chains > 0)
+            {
+                std::string range = std::to_string(low);
+
+                if (high > low)
+                {
+                    range += "-" + std::to_string(high);
+                }
+
+                std::cout << std::left << std::setw(12) << range
+                          << std::right << std::setw(11) << chains << std::endl;
+            }
+
+            low = high + 1;
+        }
+    }
+
+
+    template <typename Hasher>
+    void printStatsIfHashSet(const Set<std::string>& wordSet)
+    {
+        auto hashSet = dynamic_cast<const HashSet<std::string, Hasher>*>(&wordSet);
+
+        if (hashSet != nullptr)
+        {
+            printHashSetStats(hashSet->stats());
+        }
+    }
+
+
+    void printStatsIfPerfectHashSet(const Set<std::string>& wordSet)
+    {
+        auto perfectHashSet = dynamic_cast<const PerfectHashSet*>(&wordSet);
+
+        if (perfectHashSet == nullptr || perfectHashSet->size() == 0)
+        {
+            return;
+        }
+
+        double size = perfectHashSet->size();
+
+        std::cout << std::endl;
+        std::cout << "PERFECT HASH" << std::endl;
+
+        std::cout << std::left << std::setw(24) << "Keys" << perfectHashSet->size() << std::endl;
+        std::cout << std::left << std::setw(24) << "Buckets" << perfectHashSet->bucketCount() << std::endl;
+        std::cout << std::left << std::setw(24) << "Build Time"
+                  << std::fixed << std::setprecision(0) << perfectHashSet->buildMicroseconds() << "usec" << std::endl;
+        std::cout << std::left << std::setw(24) << "Bytes Per Key"
+                  << std::fixed << std::setprecision(2) << perfectHashSet->bytes() / size << std::endl;
+        std::cout << std::left << std::setw(24) << "Pilot Bits Per Key"
+                  << std::fixed << std::setprecision(2) << perfectHashSet->bucketCount() * 16 / size << std::endl;
+    }
+
+
     void runTimingTest(
         Set<std::string>& wordSet,
         const std::string& wordFilePath, const std::string& textFilePath)
@@ -177,12 +344,7 @@ namespace
 
         {
             stopwatch.start();
-
-            for (const std::string& word : words)
-            {
-                wordSet.add(word);
-            }
-
+            loadWordSet(wordSet, words);
             stopwatch.stop();
         }
 
@@ -206,12 +368,7 @@ namespace
         std::cout << "Storing words into empty set ..." << std::endl;
         {
             stopwatch.start();
-
-            for (const std::string& word : words)
-            {
-                emptySet.add(word);
-            }
-
+            emptySet.addAll(words.begin(), words.end());
             stopwatch.stop();
         }
 
@@ -275,6 +432,13 @@ namespace
                      - (emptySetLoadDuration + emptySetSpellCheckDuration) << "usec";
 
         std::cout << std::endl;
+
+        printStatsIfHashSet<std::function<unsigned int(const std::string&)>>(wordSet);
+        printStatsIfHashSet<ProductHash>(wordSet);
+        printStatsIfHashSet<Fnv1aHash>(wordSet);
+        printStatsIfHashSet<FastHash>(wordSet);
+        printStatsIfHashSet<SipHash>(wordSet);
+        printStatsIfPerfectHashSet(wordSet);
     }
 }
 
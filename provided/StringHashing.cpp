@@ -3,8 +3,15 @@
 // ICS 46 Winter 2022
 // Project #4: Set the Controls for the Heart of the Sun
 
+#include <algorithm>
+#include <cstring>
+#include <random>
 #include "StringHashing.hpp"
 
+#ifdef STRINGHASHING_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
 
 
 // This hash function returns zero for all strings.  As you might imagine,
@@ -50,3 +57,220 @@ unsigned int hashStringAsProduct(const std::string& word)
     return hash;
 }
 
+
+// This hash function returns the same hash value as FastHash (see
+// StringHashing.hpp), which consumes the string eight bytes at a time.
+
+unsigned int hashStringAsFast(const std::string& word)
+{
+    return FastHash{}(word);
+}
+
+
+std::uint64_t processHashSeed()
+{
+    static const std::uint64_t seed = []()
+    {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    }();
+
+    return seed;
+}
+
+
+// The second half of the key is derived from the first, by mixing it
+// with one of FastHash's constants, so one seed is enough.
+
+SipHash::SipHash()
+    : SipHash{processHashSeed(), impl_::StringHashing__mix(processHashSeed(), impl_::StringHashing__SECRET[2])}
+{
+}
+
+
+// The batched kernels below hash a group of strings (one per lane) four
+// characters at a time, for as many characters as every string in the
+// group has; each lane's next four bytes are loaded as one 32-bit value,
+// and each byte is then sign-extended (since ProductHash adds chars, which
+// may be negative) and folded into that lane's hash.  Any characters left
+// over in the longer strings are then hashed one lane at a time.  SSE2
+// has no instruction that multiplies 32-bit lanes, so it multiplies by 37
+// as (hash << 5) + (hash << 2) + hash, one character at a time; AVX2
+// instead multiplies by 37^4 and adds each character times its own power
+// of 37, so that only one multiplication each step depends on the last.
+
+namespace
+{
+    template <std::size_t Lanes>
+    std::size_t shortestOf(const std::string_view* words) noexcept
+    {
+        std::size_t shortest = words[0].size();
+
+        for (std::size_t lane = 1; lane < Lanes; ++lane)
+        {
+            shortest = std::min(shortest, words[lane].size());
+        }
+
+        return shortest;
+    }
+
+
+    inline int load32(const char* p) noexcept
+    {
+        int value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    template <std::size_t Lanes>
+    void finishLanes(
+        const std::string_view* words, std::size_t position, unsigned int* hashes) noexcept
+    {
+        for (std::size_t lane = 0; lane < Lanes; ++lane)
+        {
+            unsigned int hash = hashes[lane];
+
+            for (std::size_t i = position; i < words[lane].size(); ++i)
+            {
+                hash *= 37;
+                hash += static_cast<unsigned int>(words[lane][i]);
+            }
+
+            hashes[lane] = hash;
+        }
+    }
+}
+
+
+void impl_::StringHashing__hashManyScalar(
+    const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hashes[i] = ProductHash{}(words[i]);
+    }
+}
+
+
+#ifdef __SSE2__
+namespace
+{
+    template <int Byte>
+    __m128i times37PlusByte(__m128i hash, __m128i chunk) noexcept
+    {
+        __m128i c = _mm_srai_epi32(_mm_slli_epi32(chunk, 24 - 8 * Byte), 24);
+
+        return _mm_add_epi32(
+            _mm_add_epi32(_mm_slli_epi32(hash, 5), _mm_slli_epi32(hash, 2)),
+            _mm_add_epi32(hash, c));
+    }
+}
+
+
+void impl_::StringHashing__hashManySse2(
+    const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept
+{
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const std::string_view* group = words + i;
+        std::size_t shortest = shortestOf<4>(group);
+        std::size_t position = 0;
+
+        __m128i hash = _mm_setzero_si128();
+
+        for (; position + 4 <= shortest; position += 4)
+        {
+            __m128i chunk = _mm_set_epi32(
+                load32(group[3].data() + position), load32(group[2].data() + position),
+                load32(group[1].data() + position), load32(group[0].data() + position));
+
+            hash = times37PlusByte<0>(hash, chunk);
+            hash = times37PlusByte<1>(hash, chunk);
+            hash = times37PlusByte<2>(hash, chunk);
+            hash = times37PlusByte<3>(hash, chunk);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hashes + i), hash);
+        finishLanes<4>(group, position, hashes + i);
+    }
+
+    StringHashing__hashManyScalar(words + i, count - i, hashes + i);
+}
+#endif
+
+
+#ifdef STRINGHASHING_AVX2_KERNEL
+bool impl_::StringHashing__avx2Supported() noexcept
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+
+__attribute__((target("avx2")))
+void impl_::StringHashing__hashManyAvx2(
+    const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept
+{
+    std::size_t i = 0;
+
+    const __m256i power1 = _mm256_set1_epi32(37);
+    const __m256i power2 = _mm256_set1_epi32(37 * 37);
+    const __m256i power3 = _mm256_set1_epi32(37 * 37 * 37);
+    const __m256i power4 = _mm256_set1_epi32(37 * 37 * 37 * 37);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        const std::string_view* group = words + i;
+        std::size_t shortest = shortestOf<8>(group);
+        std::size_t position = 0;
+
+        __m256i hash = _mm256_setzero_si256();
+
+        for (; position + 4 <= shortest; position += 4)
+        {
+            __m256i chunk = _mm256_set_epi32(
+                load32(group[7].data() + position), load32(group[6].data() + position),
+                load32(group[5].data() + position), load32(group[4].data() + position),
+                load32(group[3].data() + position), load32(group[2].data() + position),
+                load32(group[1].data() + position), load32(group[0].data() + position));
+
+            __m256i c0 = _mm256_srai_epi32(_mm256_slli_epi32(chunk, 24), 24);
+            __m256i c1 = _mm256_srai_epi32(_mm256_slli_epi32(chunk, 16), 24);
+            __m256i c2 = _mm256_srai_epi32(_mm256_slli_epi32(chunk, 8), 24);
+            __m256i c3 = _mm256_srai_epi32(chunk, 24);
+
+            __m256i sum = _mm256_add_epi32(
+                _mm256_add_epi32(_mm256_mullo_epi32(c0, power3), _mm256_mullo_epi32(c1, power2)),
+                _mm256_add_epi32(_mm256_mullo_epi32(c2, power1), c3));
+
+            hash = _mm256_add_epi32(_mm256_mullo_epi32(hash, power4), sum);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hashes + i), hash);
+        finishLanes<8>(group, position, hashes + i);
+    }
+
+    StringHashing__hashManyScalar(words + i, count - i, hashes + i);
+}
+#endif
+
+
+void hashMany(const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept
+{
+#ifdef STRINGHASHING_AVX2_KERNEL
+    if (impl_::StringHashing__avx2Supported())
+    {
+        impl_::StringHashing__hashManyAvx2(words, count, hashes);
+        return;
+    }
+#endif
+
+#ifdef __SSE2__
+    impl_::StringHashing__hashManySse2(words, count, hashes);
+#else
+    impl_::StringHashing__hashManyScalar(words, count, hashes);
+#endif
+}
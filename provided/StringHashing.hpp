@@ -8,13 +8,593 @@
 #ifndef STRINGHASHING_HPP
 #define STRINGHASHING_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 
 
 unsigned int hashStringAsZero(const std::string& word);
 unsigned int hashStringAsSum(const std::string& word);
 unsigned int hashStringAsProduct(const std::string& word);
+unsigned int hashStringAsFast(const std::string& word);
+
+
+// hashMany() calculates the hash of each of the given number of strings,
+// as ProductHash (and hashStringAsProduct()) would, storing them in the
+// array "hashes."  Rather than one string at a time, it hashes four or
+// eight at once, one per lane of a SIMD register, so that the chain of
+// multiplications for each string runs alongside the others; this suits
+// the batches of same-length candidates that WordChecker generates.  The
+// widest kernel the processor supports (AVX2, SSE2, or plain scalar code)
+// is chosen when the program runs.
+
+void hashMany(const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept;
+
+
+// processHashSeed() returns a random 64-bit value chosen the first time
+// it's called and the same one every time after that, for the lifetime
+// of the process.  Hash functions keyed with it can't be predicted from
+// outside the process, so no one can prepare a set of words that are
+// known in advance to collide.
+std::uint64_t processHashSeed();
+
+
+
+// The function objects below can be given to HashSet as its hash function
+// type, e.g., HashSet<std::string, ProductHash>.  They're defined here in
+// the header, rather than in StringHashing.cpp, so that the compiler can
+// inline them into the HashSet's member functions.  Each accepts a
+// std::string_view, so a HashSet using one can answer contains() for a
+// std::string_view without building a std::string.
+
+
+// ProductHash calculates the same hash as hashStringAsProduct().
+
+struct ProductHash
+{
+    unsigned int operator()(std::string_view word) const noexcept
+    {
+        unsigned int hash = 0;
+
+        for (char c : word)
+        {
+            hash *= 37;
+            hash += static_cast<unsigned int>(c);
+        }
+
+        return hash;
+    }
+};
+
+
+// The kernels hashMany() chooses among, exposed so that they can be tested
+// and compared directly.  StringHashing__hashManyAvx2() can only be called
+// when StringHashing__avx2Supported() returns true.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define STRINGHASHING_AVX2_KERNEL 1
+#endif
+
+namespace impl_
+{
+    void StringHashing__hashManyScalar(
+        const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept;
+
+#ifdef __SSE2__
+    void StringHashing__hashManySse2(
+        const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept;
+#endif
+
+#ifdef STRINGHASHING_AVX2_KERNEL
+    bool StringHashing__avx2Supported() noexcept;
+
+    void StringHashing__hashManyAvx2(
+        const std::string_view* words, std::size_t count, unsigned int* hashes) noexcept;
+#endif
+}
+
+
+
+// RollingProductHash takes a word and then calculates, in constant time,
+// the hash (as hashStringAsProduct() would calculate it) of any of its
+// substrings, or of the word with one character replaced, inserted,
+// erased, or swapped with the next one.  That works because the product
+// hash of a string s of length n is a polynomial in 37,
+//
+//     s[0] * 37^(n-1) + s[1] * 37^(n-2) + ... + s[n-1]
+//
+// (modulo 2^32), so each edit only changes a few of its terms, and the
+// hash of the first i characters of the word is all it takes to separate
+// the terms before an edit from those after it.  assign() calculates and
+// stores those prefix hashes and the powers of 37, reusing its storage
+// from one word to the next.
+
+class RollingProductHash
+{
+public:
+    void assign(std::string_view word);
+
+    // hash() returns the hash of the whole word.
+    unsigned int hash() const noexcept;
+
+    // substring() returns the hash of the given number of characters of
+    // the word, starting at the given index.
+    unsigned int substring(std::size_t start, std::size_t length) const noexcept;
+
+    // replaced() returns the hash of the word with the character at the
+    // given index replaced by the given one.
+    unsigned int replaced(std::size_t index, char c) const noexcept;
+
+    // inserted() returns the hash of the word with the given character
+    // inserted before the given index (or at the end, if the index is the
+    // word's length).
+    unsigned int inserted(std::size_t index, char c) const noexcept;
+
+    // erased() returns the hash of the word without the character at the
+    // given index.
+    unsigned int erased(std::size_t index) const noexcept;
+
+    // swapped() returns the hash of the word with the characters at the
+    // given index and the one after it swapped.
+    unsigned int swapped(std::size_t index) const noexcept;
+
+private:
+    std::string_view word;
+
+    // prefixes[i] is the hash of the first i characters of the word, and
+    // powers[i] is 37^i, for i up to one more than the word's length.
+    std::vector<unsigned int> prefixes;
+    std::vector<unsigned int> powers;
+};
+
+
+
+inline void RollingProductHash::assign(std::string_view word)
+{
+    this->word = word;
+
+    prefixes.resize(word.length() + 1);
+    prefixes[0] = 0;
+
+    for (std::size_t i = 0; i < word.length(); ++i)
+    {
+        prefixes[i + 1] = prefixes[i] * 37 + static_cast<unsigned int>(word[i]);
+    }
+
+    for (std::size_t i = powers.size(); i < word.length() + 2; ++i)
+    {
+        powers.push_back(i == 0 ? 1 : powers[i - 1] * 37);
+    }
+}
+
+
+inline unsigned int RollingProductHash::hash() const noexcept
+{
+    return prefixes[word.length()];
+}
+
+
+inline unsigned int RollingProductHash::substring(std::size_t start, std::size_t length) const noexcept
+{
+    return prefixes[start + length] - prefixes[start] * powers[length];
+}
+
+
+inline unsigned int RollingProductHash::replaced(std::size_t index, char c) const noexcept
+{
+    return hash()
+        + (static_cast<unsigned int>(c) - static_cast<unsigned int>(word[index]))
+          * powers[word.length() - 1 - index];
+}
+
+
+inline unsigned int RollingProductHash::inserted(std::size_t index, char c) const noexcept
+{
+    std::size_t after = word.length() - index;
+
+    return prefixes[index] * powers[after + 1]
+        + static_cast<unsigned int>(c) * powers[after]
+        + substring(index, after);
+}
+
+
+inline unsigned int RollingProductHash::erased(std::size_t index) const noexcept
+{
+    std::size_t after = word.length() - index - 1;
+    return prefixes[index] * powers[after] + substring(index + 1, after);
+}
+
+
+inline unsigned int RollingProductHash::swapped(std::size_t index) const noexcept
+{
+    unsigned int first = static_cast<unsigned int>(word[index]);
+    unsigned int second = static_cast<unsigned int>(word[index + 1]);
+    std::size_t after = word.length() - 2 - index;
+
+    return hash()
+        + (second - first) * powers[after + 1]
+        + (first - second) * powers[after];
+}
+
+
+
+// Fnv1aHash calculates the 32-bit FNV-1a hash, which mixes each character
+// in with an exclusive-or and a multiplication by a prime, spreading the
+// influence of every character across all of the hash's bits.
+
+struct Fnv1aHash
+{
+    unsigned int operator()(std::string_view word) const noexcept
+    {
+        unsigned int hash = 2166136261u;
+
+        for (char c : word)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+};
+
+
+
+namespace impl_
+{
+    // Constants mixed into FastHash's state, each with an irregular mix of
+    // one and zero bits (the first four are wyhash's; the rest are from
+    // xxHash and the golden ratio).
+    inline constexpr std::uint64_t StringHashing__SECRET[8] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+        0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+        0x1d8e4e27c47d124full, 0xc2b2ae3d27d4eb4full,
+        0x165667b19e3779f9ull, 0x9e3779b97f4a7c15ull
+    };
+
+
+    // Words are read with std::memcpy, which compiles to a single load but
+    // doesn't require the characters to be aligned.
+    inline std::uint64_t StringHashing__read64(const char* p) noexcept
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    inline std::uint64_t StringHashing__read32(const char* p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    // Multiplies two 64-bit values into a 128-bit product and returns the
+    // exclusive-or of its halves, so every bit of each input affects the
+    // result.
+    inline std::uint64_t StringHashing__mix(std::uint64_t a, std::uint64_t b) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 Product;
+        Product product = static_cast<Product>(a) * b;
+        return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+        std::uint64_t aLow = a & 0xffffffffu, aHigh = a >> 32;
+        std::uint64_t bLow = b & 0xffffffffu, bHigh = b >> 32;
+        std::uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh;
+        std::uint64_t highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+        std::uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffffu) + (highLow & 0xffffffffu);
+        std::uint64_t low = (lowLow & 0xffffffffu) | (middle << 32);
+        std::uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+        return low ^ high;
+#endif
+    }
+
+
+    // Keys of at least 64 bytes are consumed in 64-byte stripes by eight
+    // independent 64-bit accumulators, as in xxh3, so the multiplications
+    // for one stripe don't wait on those of the one before.  Each lane
+    // multiplies the low and high halves of its data (keyed with a secret)
+    // together and adds its neighbor's data, so no input is lost even when
+    // a product is zero.  The SSE2 version does two lanes per instruction
+    // and calculates exactly the same result as the scalar one.
+    inline void StringHashing__accumulateScalar(
+        std::uint64_t* acc, const char* p, std::size_t stripes) noexcept
+    {
+        for (std::size_t s = 0; s < stripes; ++s, p += 64)
+        {
+            for (unsigned int i = 0; i < 8; ++i)
+            {
+                std::uint64_t data = StringHashing__read64(p + 8 * i);
+                std::uint64_t keyed = data ^ StringHashing__SECRET[i];
+                acc[i ^ 1] += data;
+                acc[i] += (keyed & 0xffffffffu) * (keyed >> 32);
+            }
+        }
+    }
+
+
+#ifdef __SSE2__
+    inline void StringHashing__accumulateSse2(
+        std::uint64_t* acc, const char* p, std::size_t stripes) noexcept
+    {
+        __m128i lanes[4];
+        __m128i secret[4];
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            lanes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2 * i));
+            secret[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(StringHashing__SECRET + 2 * i));
+        }
+
+        for (std::size_t s = 0; s < stripes; ++s, p += 64)
+        {
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+                __m128i keyed = _mm_xor_si128(data, secret[i]);
+                __m128i keyedHigh = _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+                __m128i product = _mm_mul_epu32(keyed, keyedHigh);
+                __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                lanes[i] = _mm_add_epi64(lanes[i], _mm_add_epi64(product, swapped));
+            }
+        }
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2 * i), lanes[i]);
+        }
+    }
+#endif
+}
+
+
+// FastHash is a hash in the wyhash family.  Rather than one character at
+// a time, it consumes eight bytes per step, combining each pair of 64-bit
+// words with one 64-by-64-bit multiplication (see impl_::StringHashing__mix
+// above), so a typical dictionary word takes only two or three
+// multiplications.  Keys of 64 bytes or more take a SIMD path (see
+// impl_::StringHashing__accumulateScalar above) when SSE2 is available.
+// The result doesn't depend on whether it is.
+//
+// A FastHash can also be given a seed (such as processHashSeed()), which
+// changes the hash of every string unpredictably; a default-constructed
+// one uses the seed 0.  The 32-bit result is folded from a 64-bit one,
+// which hash64() returns whole.
+
+struct FastHash
+{
+    FastHash() noexcept
+        : key{0}
+    {
+    }
+
+
+    explicit FastHash(std::uint64_t seed) noexcept
+        : key{seed}
+    {
+    }
+
+
+    unsigned int operator()(std::string_view word) const noexcept
+    {
+        std::uint64_t hash = hash64(word);
+        return static_cast<unsigned int>(hash ^ (hash >> 32));
+    }
+
+
+    std::uint64_t hash64(std::string_view word) const noexcept
+    {
+        using namespace impl_;
+
+        const char* p = word.data();
+        std::size_t length = word.size();
+
+        std::uint64_t seed = StringHashing__mix(StringHashing__SECRET[0] ^ key, StringHashing__SECRET[1]);
+        std::uint64_t a;
+        std::uint64_t b;
+
+        if (length <= 16)
+        {
+            if (length >= 4)
+            {
+                // Two (possibly overlapping) pairs of four bytes cover
+                // every byte of a key from 4 to 16 bytes long.
+                std::size_t offset = (length >> 3) << 2;
+                a = (StringHashing__read32(p) << 32) | StringHashing__read32(p + offset);
+                b = (StringHashing__read32(p + length - 4) << 32)
+                    | StringHashing__read32(p + length - 4 - offset);
+            }
+            else if (length > 0)
+            {
+                a = (static_cast<std::uint64_t>(static_cast<unsigned char>(p[0])) << 16)
+                    | (static_cast<std::uint64_t>(static_cast<unsigned char>(p[length >> 1])) << 8)
+                    | static_cast<unsigned char>(p[length - 1]);
+                b = 0;
+            }
+            else
+            {
+                a = 0;
+                b = 0;
+            }
+        }
+        else
+        {
+            std::size_t remaining = length;
+
+            if (length >= 64)
+            {
+                std::uint64_t acc[8];
+                std::memcpy(acc, StringHashing__SECRET, sizeof(acc));
+
+                std::size_t stripes = (length - 1) / 64;
+#ifdef __SSE2__
+                StringHashing__accumulateSse2(acc, p, stripes);
+#else
+                StringHashing__accumulateScalar(acc, p, stripes);
+#endif
+                for (unsigned int i = 0; i < 8; i += 2)
+                {
+                    seed ^= StringHashing__mix(acc[i] ^ StringHashing__SECRET[i], acc[i + 1] ^ seed);
+                }
+
+                p += stripes * 64;
+                remaining -= stripes * 64;
+            }
+
+            while (remaining > 16)
+            {
+                seed = StringHashing__mix(
+                    StringHashing__read64(p) ^ StringHashing__SECRET[1],
+                    StringHashing__read64(p + 8) ^ seed);
+
+                p += 16;
+                remaining -= 16;
+            }
+
+            // The last sixteen bytes of the key, some of which may have
+            // been consumed already.
+            a = StringHashing__read64(p + remaining - 16);
+            b = StringHashing__read64(p + remaining - 8);
+        }
+
+        return StringHashing__mix(
+            StringHashing__mix(a ^ StringHashing__SECRET[1], b ^ seed) ^ StringHashing__SECRET[0] ^ length,
+            StringHashing__SECRET[1]);
+    }
+
+
+    std::uint64_t key;
+};
+
+
+
+// SipHash calculates SipHash-2-4, a keyed hash designed so that, without
+// knowing its 128-bit key, no one can find strings whose hashes collide
+// any faster than by trying them at random.  That makes it the choice
+// when the words come from someone who might be trying to overload one
+// chain of a HashSet.  It's a few times slower than FastHash, processing
+// eight bytes per step with a series of additions, rotations, and
+// exclusive-ors.  A default-constructed SipHash is keyed from
+// processHashSeed(); the low 32 bits of its 64-bit result are returned.
+
+class SipHash
+{
+public:
+    SipHash();
+    SipHash(std::uint64_t key0, std::uint64_t key1) noexcept;
+
+    unsigned int operator()(std::string_view word) const noexcept;
+
+    // hash64() returns the full 64-bit result.
+    std::uint64_t hash64(std::string_view word) const noexcept;
+
+private:
+    std::uint64_t key0;
+    std::uint64_t key1;
+};
+
+
+
+namespace impl_
+{
+    inline std::uint64_t StringHashing__rotateLeft(std::uint64_t value, unsigned int bits) noexcept
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+
+    inline void StringHashing__sipRound(
+        std::uint64_t& v0, std::uint64_t& v1, std::uint64_t& v2, std::uint64_t& v3) noexcept
+    {
+        v0 += v1;
+        v1 = StringHashing__rotateLeft(v1, 13);
+        v1 ^= v0;
+        v0 = StringHashing__rotateLeft(v0, 32);
+
+        v2 += v3;
+        v3 = StringHashing__rotateLeft(v3, 16);
+        v3 ^= v2;
+
+        v0 += v3;
+        v3 = StringHashing__rotateLeft(v3, 21);
+        v3 ^= v0;
+
+        v2 += v1;
+        v1 = StringHashing__rotateLeft(v1, 17);
+        v1 ^= v2;
+        v2 = StringHashing__rotateLeft(v2, 32);
+    }
+}
+
+
+inline SipHash::SipHash(std::uint64_t key0, std::uint64_t key1) noexcept
+    : key0{key0}, key1{key1}
+{
+}
+
+
+inline unsigned int SipHash::operator()(std::string_view word) const noexcept
+{
+    return static_cast<unsigned int>(hash64(word));
+}
+
+
+inline std::uint64_t SipHash::hash64(std::string_view word) const noexcept
+{
+    using namespace impl_;
+
+    std::uint64_t v0 = key0 ^ 0x736f6d6570736575ull;
+    std::uint64_t v1 = key1 ^ 0x646f72616e646f6dull;
+    std::uint64_t v2 = key0 ^ 0x6c7967656e657261ull;
+    std::uint64_t v3 = key1 ^ 0x7465646279746573ull;
+
+    const char* p = word.data();
+    std::size_t length = word.size();
+    std::size_t whole = length & ~static_cast<std::size_t>(7);
+
+    for (std::size_t i = 0; i < whole; i += 8)
+    {
+        std::uint64_t m = StringHashing__read64(p + i);
+        v3 ^= m;
+        StringHashing__sipRound(v0, v1, v2, v3);
+        StringHashing__sipRound(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // The last block holds the remaining bytes (little-endian) with the
+    // length of the whole string in its top byte.
+    std::uint64_t last = static_cast<std::uint64_t>(length) << 56;
+
+    for (std::size_t i = whole; i < length; ++i)
+    {
+        last |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * (i - whole));
+    }
+
+    v3 ^= last;
+    StringHashing__sipRound(v0, v1, v2, v3);
+    StringHashing__sipRound(v0, v1, v2, v3);
+    v0 ^= last;
+
+    v2 ^= 0xff;
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        StringHashing__sipRound(v0, v1, v2, v3);
+    }
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
 
 
 
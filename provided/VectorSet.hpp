@@ -11,6 +11,9 @@
 #define VECTORSET_HPP
 
 #include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 #include "Set.hpp"
 
 
@@ -28,7 +31,9 @@ public:
 
     bool isImplemented() const noexcept override;
     void add(const ElementType& element) override;
+    using Set<ElementType>::contains;
     bool contains(const ElementType& element) const override;
+    bool contains(std::string_view element) const override;
     unsigned int size() const noexcept override;
 
 private:
@@ -105,6 +110,22 @@ bool VectorSet<ElementType>::contains(const ElementType& element) const
 }
 
 
+template <typename ElementType>
+bool VectorSet<ElementType>::contains(std::string_view element) const
+{
+    if constexpr (std::is_convertible_v<const ElementType&, std::string_view>)
+    {
+        return std::any_of(
+            elements.begin(), elements.end(),
+            [&](const ElementType& e) { return std::string_view{e} == element; });
+    }
+    else
+    {
+        return Set<ElementType>::contains(element);
+    }
+}
+
+
 template <typename ElementType>
 unsigned int VectorSet<ElementType>::size() const noexcept
 {